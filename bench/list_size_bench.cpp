@@ -0,0 +1,69 @@
+/* file		: bench/list_size_bench.cpp
+ * by		: waterlemon	429426523@qq.com
+ * date		: Mon 19 Oct 2026 10:48:20 AM CST
+ * last update	:
+ *
+ * description	: list::size() 由 O(n) 改为 O(1) 前后的比较
+ * 以 size() 作为循环条件走过整个 list:
+ *      for (i = 0, it = l.begin(); i < l.size(); ++i, ++it) ...
+ *      before: 以前的 size() 是 distance(begin(), end())，整个循环是 O(n^2)，
+ *              这里直接以 mystl::distance() 代替
+ *      after:  现在的 size() 读取 length，整个循环是 O(n)
+ *
+ * 编译: g++ -std=c++11 -O2 -I.. list_size_bench.cpp -o list_size_bench
+ * 执行: ./list_size_bench
+ */
+
+#include "mystl_list.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+typedef mystl::list<int> int_list;
+
+volatile long bench_sink;           /* 防止计时的循环被优化掉 */
+
+/* 以前的 size() */
+struct old_size {
+    size_t operator() (int_list& l) const { return mystl::distance(l.begin(), l.end()); }
+};
+/* 现在的 size() */
+struct new_size {
+    size_t operator() (int_list& l) const { return l.size(); }
+};
+
+/* 返回走过一次所用的毫秒数 */
+template <typename Size>
+double walk(int_list& l, size_t rounds)
+{
+    Size size;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; r++) {
+        long sum = 0;
+        int_list::iterator it = l.begin();
+        for (size_t i = 0; i < size(l); ++i, ++it)
+            sum += *it;
+        bench_sink = sum;
+    }
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return sec * 1e3 / rounds;
+}
+
+int main()
+{
+    printf("%-10s %14s %14s %10s\n", "length", "before (ms)", "after (ms)", "speedup");
+    const size_t lengths[] = { 1000, 4000, 16000, 32000 };
+    for (size_t k = 0; k < sizeof lengths / sizeof lengths[0]; k++) {
+        size_t n = lengths[k];
+        int_list l;
+        for (size_t i = 0; i < n; i++)
+            l.push_back((int) i);
+
+        /* before 是 O(n^2)，跑的次数少一些，长的 list 只跑一次 */
+        size_t old_rounds = 64000000 / (n * n) > 0 ? 64000000 / (n * n) : 1;
+        double before = walk<old_size>(l, old_rounds);
+        double after = walk<new_size>(l, 64000000 / n);
+        printf("%-10zu %14.3f %14.4f %9.0fx\n", n, before, after, before / after);
+    }
+    return 0;
+}
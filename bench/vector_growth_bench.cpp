@@ -0,0 +1,80 @@
+/* file		: bench/vector_growth_bench.cpp
+ * by		: waterlemon	429426523@qq.com
+ * date		: Mon 19 Oct 2026 10:12:36 AM CST
+ * last update	:
+ *
+ * description	: vector 扩充策略的空间与速度比较
+ * 对 growth_x2、growth_x1_5 与 growth_size_class，把 n 个 int 逐个 push_back()，记录
+ *      reallocs: 容量改变的次数
+ *      slack:    最后的 capacity() 比 size() 多出的比例
+ *      peak:     配置器上同时在用的最大字节数 (instrumented_alloc 的 peak_bytes)，
+ *                以及它与 n * sizeof (int) 的比值；realloc() 内部搬移时的暂时占用不计
+ *      M/s:      每秒 push_back() 的次数 (百万次)
+ * 配置器为 instrumented_alloc<malloc_alloc>，int 可以逐字节搬移，扩充时经由 realloc()。
+ *
+ * 编译: g++ -std=c++11 -O2 -I.. vector_growth_bench.cpp -o vector_growth_bench
+ * 执行: ./vector_growth_bench
+ */
+
+#include "mystl_vector.hpp"
+#include "mystl_alloc_stats.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+typedef mystl::instrumented_alloc<mystl::malloc_alloc>  bench_alloc;
+
+enum { __BENCH_TOTAL = 1 << 24 };   /* 每一行合计 push_back() 的次数，n 小时重复多次 */
+
+volatile long bench_sink;           /* 防止计时的循环被优化掉 */
+
+template <typename Growth>
+void bench(const char* name, size_t n)
+{
+    typedef mystl::vector<int, bench_alloc, Growth> vec;
+
+    /* 第一次: 记录容量的变化与配置器的统计 */
+    bench_alloc::stats().reset();
+    size_t reallocs = 0;
+    double slack;
+    {
+        vec v;
+        size_t cap = v.capacity();
+        for (size_t i = 0; i < n; i++) {
+            v.push_back((int) i);
+            if (v.capacity() != cap) {
+                cap = v.capacity();
+                ++reallocs;
+            }
+        }
+        slack = (double) (v.capacity() - v.size()) / v.size();
+    }
+    size_t peak = bench_alloc::stats().snapshot().peak_bytes;
+
+    /* 之后: 只计时 */
+    size_t rounds = __BENCH_TOTAL / n > 0 ? __BENCH_TOTAL / n : 1;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; r++) {
+        vec v;
+        for (size_t i = 0; i < n; i++)
+            v.push_back((int) i);
+        bench_sink = v[n - 1];
+    }
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("%-10zu %-18s %8zu %8.1f%% %14zu %6.2fx %10.1f\n", n, name, reallocs,
+           slack * 100, peak, (double) peak / (n * sizeof (int)), rounds * n / sec / 1e6);
+}
+
+int main()
+{
+    printf("%-10s %-18s %8s %9s %14s %7s %10s\n",
+           "n", "policy", "reallocs", "slack", "peak bytes", "peak/n", "M/s");
+    const size_t sizes[] = { 100, 1000, 10000, 100000, 1000000, 10000000 };
+    for (size_t i = 0; i < sizeof sizes / sizeof sizes[0]; i++) {
+        bench<mystl::growth_x2>("growth_x2", sizes[i]);
+        bench<mystl::growth_x1_5>("growth_x1_5", sizes[i]);
+        bench<mystl::growth_size_class>("growth_size_class", sizes[i]);
+    }
+    return 0;
+}
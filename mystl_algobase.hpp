@@ -14,6 +14,7 @@
 
 #include <cstring>      /* memmove() */
 #include <cstddef>      /* ptrdiff_t */
+#include <utility>      /* std::move() */
 
 namespace mystl
 {
@@ -169,6 +170,50 @@ inline T* __copy_t(const T* first, const T* last, T* result, __false_type)
 }
 
 
+/* move() */
+/* 与 copy() 相同，但以移动赋值代替复制赋值 */
+template <typename InputIterator, typename OutputIterator>
+inline OutputIterator move(InputIterator first, InputIterator last, OutputIterator result)
+{
+    for (; first != last; ++first, ++result)
+        *result = std::move(*first);
+    return result;
+}
+
+template <typename T>
+inline T* __move_t(T* first, T* last, T* result, __true_type)
+{
+    memmove(result, first, sizeof (T) * (last - first));
+    return result + (last - first);
+}
+
+template <typename T>
+inline T* __move_t(T* first, T* last, T* result, __false_type)
+{
+    for (; first != last; ++first, ++result)
+        *result = std::move(*first);
+    return result;
+}
+
+/* 针对原生指针: has_trivial_assignment_operator 的型别直接 memmove() */
+template <typename T>
+inline T* move(T* first, T* last, T* result)
+{
+    typedef typename __type_traits<T>::has_trivial_assignment_operator t;
+    return __move_t(first, last, result, t());
+}
+
+/* move_backward() */
+template <typename BidirectionalIterator1, typename BidirectionalIterator2>
+BidirectionalIterator2 move_backward(BidirectionalIterator1 first,
+        BidirectionalIterator1 last, BidirectionalIterator2 result)
+{
+    while (last != first)
+        *(--result) = std::move(*(--last));
+    return result;
+}
+
+
 /* copy_backward() */
 //! 没有进行效率上的优化
 template <typename BidirectionalIterator1, typename BidirectionalIterator2>
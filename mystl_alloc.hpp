@@ -3,13 +3,18 @@
  * date		: 2019年 08月 05日 星期一 09:47:29 CST
  * last update	: 
  * 
- * description	: simple_alloc, alloc, malloc_alloc
+ * description	: simple_alloc, alloc, malloc_alloc, default_alloc, single_client_alloc, __alloc_holder,
+ *      align_alloc, __alloc_align, __alloc_reserve, __alloc_equal
  */
 
 #ifndef     _MYSTL_ALLOC_
 #define     _MYSTL_ALLOC_
 
 #include <cstdlib>      /* malloc(), free(), realloc() */
+#include <cstring>      /* memcpy() */
+#include <cstddef>      /* size_t, max_align_t */
+#include <mutex>        /* std::mutex */
+#include <utility>      /* std::move() */
 
 #if 0
 #include <new>
@@ -22,7 +27,13 @@
 namespace mystl
 {
 
-class malloc_alloc {
+/* malloc() 保证的对齐量 */
+enum { __MAX_ALIGN = alignof(std::max_align_t) };
+
+/* 与 __default_alloc_template 一样做成模板，static 数据成员与 oom 处理函数
+ * 才可以定义在头文件中。inst 没有其他用途，使用 malloc_alloc 即可 */
+template <int inst>
+class __malloc_alloc_template {
 private:
     // oom: out of memory
     static void* oom_malloc(size_t n);
@@ -44,9 +55,33 @@ public:
         free(p);
     }
 
+    /* align 必须是 2 的幂次。align 超过 malloc 的保证时，
+     * 多配置 align 个字节，并在对齐后地址的前面保存原始地址 */
+    static void* allocate(size_t n, size_t align)
+    {
+        if (align <= (size_t) __MAX_ALIGN)
+            return allocate(n);
+        char* raw = (char*) allocate(n + align);
+        char* p = (char*) (((size_t) raw + align) & ~(align - 1));
+        ((void**) p)[-1] = raw;
+        return p;
+    }
+
+    static void deallocate(void* p, size_t n, size_t align)
+    {
+        if (align <= (size_t) __MAX_ALIGN)
+            deallocate(p, n);
+        else
+            deallocate(((void**) p)[-1], n + align);
+    }
+
+    /* glibc 对大区块 (超过 mmap 门槛) 直接使用 mmap，
+     * 这样的区块 realloc 时以 mremap 重新映射页面，不需要复制内容 */
     static void* reallocate(void* p, size_t /* old_sz */, size_t new_sz)
     {
         void* result = realloc(p, new_sz);
+        if (result == 0)
+            result = oom_realloc(p, new_sz);
         return result;
     }
 
@@ -60,9 +95,11 @@ public:
 };
 
 /* malloc_alloc oom handling */
-void (*malloc_alloc::__malloc_alloc_oom_handler)() = 0;
+template <int inst>
+void (*__malloc_alloc_template<inst>::__malloc_alloc_oom_handler)() = 0;
 
-void* malloc_alloc::oom_malloc(size_t n)
+template <int inst>
+void* __malloc_alloc_template<inst>::oom_malloc(size_t n)
 {
     void (*my_malloc_handler)();
     void* result;
@@ -78,7 +115,8 @@ void* malloc_alloc::oom_malloc(size_t n)
     }
 }
 
-void* malloc_alloc::oom_realloc(void* p, size_t n)
+template <int inst>
+void* __malloc_alloc_template<inst>::oom_realloc(void* p, size_t n)
 {
     void (*my_malloc_handler)();
     void* result;
@@ -94,7 +132,236 @@ void* malloc_alloc::oom_realloc(void* p, size_t n)
     }
 }
 
-typedef     malloc_alloc        alloc;
+typedef     __malloc_alloc_template<0>      malloc_alloc;
+
+/* 第二级配置器 __default_alloc_template
+ * 区块大于 __MAX_BYTES 时交给第一级配置器 malloc_alloc 处理；
+ * 小区块则由 memory pool 管理: 维护 __NFREELISTS 个 free-list，
+ * 各自管理 8, 16, 24, ..., 128 bytes 的小区块，
+ * free-list 为空时从 memory pool 中一次取出多个区块填充 (refill)。
+ * 小区块的内存不会归还给系统，只会回到对应的 free-list 中。
+ * threads 为 true 时 free-list 与 memory pool 由一个 mutex 保护，可以在多个线程中使用:
+ *      default_alloc           加锁，是缺省的 alloc
+ *      single_client_alloc     不加锁，只能在一个线程中使用 */
+enum { __ALIGN = 8 };                           /* 小区块的上调边界 */
+enum { __MAX_BYTES = 128 };                     /* 小区块的上限 */
+enum { __NFREELISTS = __MAX_BYTES / __ALIGN };  /* free-list 个数 */
+
+template <bool threads>
+class __default_alloc_template {
+private:
+    /* 将 bytes 上调至 __ALIGN 的倍数 */
+    static size_t ROUND_UP(size_t bytes)
+        { return (bytes + __ALIGN - 1) & ~((size_t) __ALIGN - 1); }
+
+    /* free-list 的结点: 区块未分配时，前 sizeof(obj*) 个字节用作链接指针 */
+    union obj {
+        union obj* free_list_link;
+        char client_data[1];
+    };
+
+    /* 根据区块大小决定使用第 n 号 free-list，n 从 0 起算 */
+    static size_t FREELIST_INDEX(size_t bytes)
+        { return (bytes + __ALIGN - 1) / __ALIGN - 1; }
+
+    static obj* free_list[__NFREELISTS];
+
+    /* 返回一个大小为 n 的对象，并可能加入大小为 n 的其他区块到 free-list */
+    static void* refill(size_t n);
+    /* 配置一大块空间，可容纳 nobjs 个大小为 size 的区块
+     * 如果配置 nobjs 个区块有所不便，nobjs 可能会减少 */
+    static char* chunk_alloc(size_t size, int& nobjs);
+
+    /* memory pool */
+    static char*  start_free;       /* 内存池起始位置，只在 chunk_alloc() 中变化 */
+    static char*  end_free;         /* 内存池结束位置，只在 chunk_alloc() 中变化 */
+    static size_t heap_size;        /* 已向系统申请的总量，用于决定追加量 */
+
+    /* allocate()/deallocate() 进入时取得锁，离开时释放；
+     * refill() 与 chunk_alloc() 只在持有锁时被调用，本身不再加锁 */
+    static std::mutex pool_mutex;
+    class lock {
+    public:
+        lock() { if (threads) pool_mutex.lock(); }
+        ~lock() { if (threads) pool_mutex.unlock(); }
+    };
+
+public:
+    static void* allocate(size_t n)
+    {
+        if (n > (size_t) __MAX_BYTES)
+            return malloc_alloc::allocate(n);
+
+        lock guard;
+        obj** my_free_list = free_list + FREELIST_INDEX(n);
+        obj* result = *my_free_list;
+        if (result == 0)                /* 没有可用的区块，重新填充 free-list */
+            return refill(ROUND_UP(n));
+        *my_free_list = result->free_list_link;
+        return result;
+    }
+
+    static void deallocate(void* p, size_t n)
+    {
+        if (n > (size_t) __MAX_BYTES) {
+            malloc_alloc::deallocate(p, n);
+            return;
+        }
+
+        /* 回收区块，放到对应 free-list 的头部 */
+        lock guard;
+        obj* q = (obj*) p;
+        obj** my_free_list = free_list + FREELIST_INDEX(n);
+        q->free_list_link = *my_free_list;
+        *my_free_list = q;
+    }
+
+    /* free-list 中的区块只保证 __ALIGN 对齐，更高的对齐要求交给第一级配置器 */
+    static void* allocate(size_t n, size_t align)
+    {
+        if (align <= (size_t) __ALIGN)
+            return allocate(n);
+        return malloc_alloc::allocate(n, align);
+    }
+
+    static void deallocate(void* p, size_t n, size_t align)
+    {
+        if (align <= (size_t) __ALIGN)
+            deallocate(p, n);
+        else
+            malloc_alloc::deallocate(p, n, align);
+    }
+
+    static void* reallocate(void* p, size_t old_sz, size_t new_sz);
+};
+
+/* __default_alloc_template static data member */
+template <bool threads>
+char*  __default_alloc_template<threads>::start_free = 0;
+template <bool threads>
+char*  __default_alloc_template<threads>::end_free = 0;
+template <bool threads>
+size_t __default_alloc_template<threads>::heap_size = 0;
+template <bool threads>
+std::mutex __default_alloc_template<threads>::pool_mutex;
+template <bool threads>
+typename __default_alloc_template<threads>::obj*
+__default_alloc_template<threads>::free_list[__NFREELISTS] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+/* n 已经上调至 __ALIGN 的倍数
+ * 缺省取得 20 个新区块，内存池不足时可能少于 20 个 */
+template <bool threads>
+void* __default_alloc_template<threads>::refill(size_t n)
+{
+    int nobjs = 20;
+    char* chunk = chunk_alloc(n, nobjs);
+
+    /* 只获得一个区块，直接交给调用者，free-list 无新结点 */
+    if (nobjs == 1)
+        return chunk;
+
+    obj** my_free_list = free_list + FREELIST_INDEX(n);
+    obj* result = (obj*) chunk;         /* 第一块返回给调用者 */
+
+    /* 其余区块串接成 free-list */
+    obj* next_obj = (obj*) (chunk + n);
+    *my_free_list = next_obj;
+    for (int i = 1; ; i++) {
+        obj* current_obj = next_obj;
+        next_obj = (obj*) ((char*) next_obj + n);
+        if (nobjs - 1 == i) {
+            current_obj->free_list_link = 0;
+            break;
+        }
+        current_obj->free_list_link = next_obj;
+    }
+    return result;
+}
+
+/* size 已经上调至 __ALIGN 的倍数 */
+template <bool threads>
+char* __default_alloc_template<threads>::chunk_alloc(size_t size, int& nobjs)
+{
+    char* result;
+    size_t total_bytes = size * nobjs;
+    size_t bytes_left = end_free - start_free;     /* 内存池剩余空间 */
+
+    if (bytes_left >= total_bytes) {
+        /* 内存池剩余空间完全满足需求量 */
+        result = start_free;
+        start_free += total_bytes;
+        return result;
+    }
+    else if (bytes_left >= size) {
+        /* 内存池剩余空间不能完全满足需求量，但足够供应一个以上的区块 */
+        nobjs = (int) (bytes_left / size);
+        total_bytes = size * nobjs;
+        result = start_free;
+        start_free += total_bytes;
+        return result;
+    }
+    else {
+        /* 内存池剩余空间连一个区块都无法提供 */
+        size_t bytes_to_get = 2 * total_bytes + ROUND_UP(heap_size >> 4);
+
+        /* 将内存池中的残余零头配给适当的 free-list */
+        if (bytes_left > 0) {
+            obj** my_free_list = free_list + FREELIST_INDEX(bytes_left);
+            ((obj*) start_free)->free_list_link = *my_free_list;
+            *my_free_list = (obj*) start_free;
+        }
+
+        start_free = (char*) malloc(bytes_to_get);
+        if (start_free == 0) {
+            /* heap 空间不足，搜寻 free-list 中尚未使用且足够大的区块 */
+            for (size_t i = size; i <= (size_t) __MAX_BYTES; i += __ALIGN) {
+                obj** my_free_list = free_list + FREELIST_INDEX(i);
+                obj* p = *my_free_list;
+                if (p != 0) {
+                    *my_free_list = p->free_list_link;
+                    start_free = (char*) p;
+                    end_free = start_free + i;
+                    /* 递归调用自己，修正 nobjs */
+                    return chunk_alloc(size, nobjs);
+                }
+            }
+            /* 山穷水尽，交给第一级配置器，看看 oom 机制能否尽点力 */
+            end_free = 0;
+            start_free = (char*) malloc_alloc::allocate(bytes_to_get);
+        }
+        heap_size += bytes_to_get;
+        end_free = start_free + bytes_to_get;
+        return chunk_alloc(size, nobjs);
+    }
+}
+
+template <bool threads>
+void* __default_alloc_template<threads>::reallocate(void* p, size_t old_sz, size_t new_sz)
+{
+    if (old_sz > (size_t) __MAX_BYTES && new_sz > (size_t) __MAX_BYTES)
+        return malloc_alloc::reallocate(p, old_sz, new_sz);
+    if (ROUND_UP(old_sz) == ROUND_UP(new_sz))
+        return p;
+
+    void* result = allocate(new_sz);
+    size_t copy_sz = new_sz > old_sz ? old_sz : new_sz;
+    memcpy(result, p, copy_sz);
+    deallocate(p, old_sz);
+    return result;
+}
+
+typedef     __default_alloc_template<true>      default_alloc;
+typedef     __default_alloc_template<false>     single_client_alloc;
+
+/* 定义 __STL_ALLOC_STATS 时，alloc 会记录配置统计 (见 mystl_alloc_stats.hpp) */
+#ifdef __STL_ALLOC_STATS
+template <typename Alloc> class static_instrumented_alloc;
+typedef     static_instrumented_alloc<default_alloc>    alloc;
+#else
+typedef     default_alloc       alloc;
+#endif
 
 template <typename T, typename Alloc = alloc>
 class simple_alloc {
@@ -107,8 +374,117 @@ public:
         { if (n != 0) Alloc::deallocate(p, n * sizeof (T)); }
     static void deallocate(T* p)
         { Alloc::deallocate(p, sizeof (T)); }
+
+    /* 有状态的配置器 (如 arena_alloc): 通过容器持有的 Alloc 对象配置空间。
+     * 对只有 static 成员的配置器，效果与上面的版本相同 */
+    static T* allocate(Alloc& a, size_t n)
+        { return n == 0 ? 0 : (T*) a.allocate(n * sizeof (T)); }
+    static T* allocate(Alloc& a)
+        { return (T*) a.allocate(sizeof (T)); }
+    static void deallocate(Alloc& a, T* p, size_t n)
+        { if (n != 0) a.deallocate(p, n * sizeof (T)); }
+    static void deallocate(Alloc& a, T* p)
+        { a.deallocate(p, sizeof (T)); }
+    /* 只能用于可以逐字节搬移的型别 */
+    static T* reallocate(Alloc& a, T* p, size_t old_n, size_t new_n)
+    {
+        if (p == 0)
+            return allocate(a, new_n);
+        return (T*) a.reallocate(p, old_n * sizeof (T), new_n * sizeof (T));
+    }
+
+    /* 对齐版本: 起始地址是 align 的整数倍，Alloc 需要提供 allocate(n, align) */
+    static T* allocate(size_t n, size_t align)
+        { return n == 0 ? 0 : (T*) Alloc::allocate(n * sizeof (T), align); }
+    static void deallocate(T* p, size_t n, size_t align)
+        { if (n != 0) Alloc::deallocate(p, n * sizeof (T), align); }
+    static T* allocate(Alloc& a, size_t n, size_t align)
+        { return n == 0 ? 0 : (T*) a.allocate(n * sizeof (T), align); }
+    static void deallocate(Alloc& a, T* p, size_t n, size_t align)
+        { if (n != 0) a.deallocate(p, n * sizeof (T), align); }
+};
+
+/* 容器持有配置器对象的基类。
+ * Alloc 为空类 (malloc_alloc, default_alloc) 时借助空基类优化，不增加容器的大小 */
+template <typename Alloc>
+class __alloc_holder : protected Alloc {
+public:
+    typedef Alloc   allocator_type;
+
+    __alloc_holder() {}
+    __alloc_holder(const Alloc& a) : Alloc(a) {}
+    /* 容器的移动构造使用: 有状态的配置器 (如 slab_alloc) 必须随区块一起移走，
+     * 复制得到的配置器并不拥有这些区块 */
+    __alloc_holder(Alloc&& a) : Alloc(std::move(a)) {}
+
+    allocator_type get_allocator() const { return *this; }
+
+protected:
+    Alloc& allocator() { return *this; }
+};
+
+/* align_alloc 把配置器 Alloc 的每一次配置都对齐到 Align (2 的幂次)，
+ * 并把区块大小补齐到 Align 的整数倍。用于 SIMD 与避免 false sharing:
+ *      vector<float, align_alloc<32> > v;     // v.begin() 32 字节对齐 */
+template <size_t Align, typename Alloc = alloc>
+class align_alloc : private Alloc {
+private:
+    Alloc& base() { return *this; }
+
+    static size_t round_up(size_t bytes)
+        { return (bytes + Align - 1) & ~(Align - 1); }
+
+public:
+    enum { alignment = Align };
+
+    align_alloc() {}
+    align_alloc(const Alloc& a) : Alloc(a) {}
+
+    void* allocate(size_t n) { return base().allocate(round_up(n), Align); }
+    void  deallocate(void* p, size_t n) { base().deallocate(p, round_up(n), Align); }
+
+    /* 底层的 reallocate() 不保证对齐，所以配置新区块再复制 */
+    void* reallocate(void* p, size_t old_sz, size_t new_sz)
+    {
+        if (round_up(old_sz) == round_up(new_sz))
+            return p;
+        void* result = allocate(new_sz);
+        memcpy(result, p, old_sz < new_sz ? old_sz : new_sz);
+        deallocate(p, old_sz);
+        return result;
+    }
+};
+
+/* 配置器保证的对齐量。vector 据此把容量补齐到对齐量的整数倍，
+ * 这样 SIMD 循环可以整块处理到 capacity 而不需要尾部的标量循环 */
+template <typename Alloc>
+struct __alloc_align {
+    enum { value = 1 };
+};
+
+template <size_t Align, typename Alloc>
+struct __alloc_align<align_alloc<Align, Alloc> > {
+    enum { value = Align };
+};
+
+/* 容器事先知道要配置 n 个大小为 size 的区块时 (如 list(n, x))，通知配置器一次准备好。
+ * 缺省什么也不做，能够批量配置的配置器 (如 slab_alloc) 特化本模板 */
+template <typename Alloc>
+struct __alloc_reserve {
+    static void reserve(Alloc& /* a */, size_t /* n */, size_t /* size */) {}
+};
+
+/* a 配置的区块能否交给 b 释放，决定结点能否在两个容器之间直接搬移 (如 list::splice())。
+ * 缺省为真 (static 配置器)，对象各自持有内存的配置器以 operator== 特化本模板 */
+template <typename Alloc>
+struct __alloc_equal {
+    static bool equal(const Alloc& /* a */, const Alloc& /* b */) { return true; }
 };
 
 }
 
+#ifdef __STL_ALLOC_STATS
+#include "mystl_alloc_stats.hpp"    /* static_instrumented_alloc{} */
+#endif
+
 #endif
@@ -0,0 +1,296 @@
+/* file		: mystl_alloc_stats.hpp
+ * by		: waterlemon	429426523@qq.com
+ * date		: Sat 17 Oct 2026 03:12:05 PM CST
+ * last update	:
+ *
+ * description	: alloc_stats, alloc_stats_snapshot, instrumented_alloc, static_instrumented_alloc
+ * instrumented_alloc<Alloc> 包装任意配置器，记录配置/释放/重新配置的次数，
+ * 按大小分组的次数与字节数，以及 live bytes 与 peak bytes。
+ * 不超过 __MAX_BYTES 的请求按 default_alloc 的 free-list (每 __ALIGN 字节一组) 分组，
+ * 更大的请求按 2 的幂次分组。
+ * 计数器是 relaxed 的原子变量，可以长期开启。
+ *
+ * 两种用法:
+ *  (1) 显式包装: vector<int, instrumented_alloc<default_alloc> > v;
+ *  (2) 编译期开关: 定义 __STL_ALLOC_STATS 后 alloc 即为 static_instrumented_alloc<default_alloc>，
+ *      它的成员函数都是 static 的，simple_alloc<T, alloc>::allocate(n) 等写法照常可用；
+ *      与 instrumented_alloc<default_alloc> 共用同一份统计数据。不定义时没有任何额外开销。
+ * 通过 instrumented_alloc<Alloc>::stats().snapshot() 取得快照，输出为文本或 JSON。
+ */
+
+#ifndef     _MYSTL_ALLOC_STATS_
+#define     _MYSTL_ALLOC_STATS_
+
+#include "mystl_alloc.hpp"      /* default_alloc{}, __ALIGN, __MAX_BYTES, __NFREELISTS */
+
+#include <atomic>               /* std::atomic<> */
+#include <string>               /* std::string */
+#include <cstdio>               /* snprintf() */
+#include <cstddef>              /* size_t */
+
+namespace mystl
+{
+
+/* 前 __NFREELISTS 组对应 free-list: 第 i 组记录大小在 (i * __ALIGN, (i + 1) * __ALIGN] 之间的请求，
+ * 0 字节算在第 0 组；之后第 __NFREELISTS + k 组记录 (__MAX_BYTES * 2^k, __MAX_BYTES * 2^(k+1)]，
+ * 最后一组的上限为 size_t(-1) */
+enum { __STATS_NBUCKETS = __NFREELISTS + sizeof (size_t) * 8 };
+
+struct alloc_stats_snapshot {
+    size_t  allocs;
+    size_t  deallocs;
+    size_t  reallocs;
+    size_t  bytes_allocated;        /* 累计配置的字节数 */
+    size_t  live_bytes;             /* 目前仍在使用的字节数 */
+    size_t  peak_bytes;             /* live_bytes 的最大值 */
+    size_t  bucket_count[__STATS_NBUCKETS];
+    size_t  bucket_bytes[__STATS_NBUCKETS];
+
+    /* 每个字段单独格式化再接上，一个 size_t 最多 20 位，不会被截断 */
+    std::string to_text() const
+    {
+        std::string s;
+        append(s, "allocs ", allocs, " ");
+        append(s, "deallocs ", deallocs, " ");
+        append(s, "reallocs ", reallocs, "\n");
+        append(s, "bytes_allocated ", bytes_allocated, " ");
+        append(s, "live_bytes ", live_bytes, " ");
+        append(s, "peak_bytes ", peak_bytes, "\n");
+        for (int i = 0; i < __STATS_NBUCKETS; i++) {
+            if (bucket_count[i] == 0)
+                continue;
+            char buf[96];
+            snprintf(buf, sizeof buf, "  <= %-20zu count %-20zu bytes %zu\n",
+                    bucket_limit(i), bucket_count[i], bucket_bytes[i]);
+            s += buf;
+        }
+        return s;
+    }
+
+    std::string to_json() const
+    {
+        std::string s;
+        append(s, "{\"allocs\":", allocs, ",");
+        append(s, "\"deallocs\":", deallocs, ",");
+        append(s, "\"reallocs\":", reallocs, ",");
+        append(s, "\"bytes_allocated\":", bytes_allocated, ",");
+        append(s, "\"live_bytes\":", live_bytes, ",");
+        append(s, "\"peak_bytes\":", peak_bytes, ",\"sizes\":[");
+        bool first = true;
+        for (int i = 0; i < __STATS_NBUCKETS; i++) {
+            if (bucket_count[i] == 0)
+                continue;
+            append(s, first ? "{\"le\":" : ",{\"le\":", bucket_limit(i), ",");
+            append(s, "\"count\":", bucket_count[i], ",");
+            append(s, "\"bytes\":", bucket_bytes[i], "}");
+            first = false;
+        }
+        s += "]}";
+        return s;
+    }
+
+    /* 第 i 组的上限 */
+    static size_t bucket_limit(int i)
+    {
+        if (i < (int) __NFREELISTS)
+            return (size_t) (i + 1) * __ALIGN;
+        size_t limit = __MAX_BYTES;
+        for (int k = __NFREELISTS; k <= i; k++) {
+            if (limit > (size_t) -1 / 2)
+                return (size_t) -1;
+            limit *= 2;
+        }
+        return limit;
+    }
+
+private:
+    static void append(std::string& s, const char* label, size_t value, const char* suffix)
+    {
+        char buf[24];
+        snprintf(buf, sizeof buf, "%zu", value);
+        s += label;
+        s += buf;
+        s += suffix;
+    }
+};
+
+class alloc_stats {
+private:
+    std::atomic<size_t> allocs;
+    std::atomic<size_t> deallocs;
+    std::atomic<size_t> reallocs;
+    std::atomic<size_t> bytes_allocated;
+    std::atomic<size_t> live_bytes;
+    std::atomic<size_t> peak_bytes;
+    std::atomic<size_t> bucket_count[__STATS_NBUCKETS];
+    std::atomic<size_t> bucket_bytes[__STATS_NBUCKETS];
+
+    /* 大小为 n 的请求所属的组，与 alloc_stats_snapshot::bucket_limit() 对应 */
+    static int bucket(size_t n)
+    {
+        if (n <= (size_t) __MAX_BYTES)
+            return n == 0 ? 0 : (int) ((n - 1) / __ALIGN);
+        int i = __NFREELISTS;
+        for (size_t limit = (size_t) __MAX_BYTES * 2; n > limit; limit *= 2) {
+            ++i;
+            if (limit > (size_t) -1 / 2)
+                break;
+        }
+        return i;
+    }
+
+    void add_live(size_t n)
+    {
+        size_t live = live_bytes.fetch_add(n, std::memory_order_relaxed) + n;
+        size_t peak = peak_bytes.load(std::memory_order_relaxed);
+        while (live > peak &&
+                !peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+            ;
+    }
+
+    /* 禁止复制 */
+    alloc_stats(const alloc_stats&);
+    alloc_stats& operator= (const alloc_stats&);
+
+public:
+    alloc_stats() { live_bytes = 0; reset(); }
+
+    void on_allocate(size_t n)
+    {
+        int i = bucket(n);
+        allocs.fetch_add(1, std::memory_order_relaxed);
+        bytes_allocated.fetch_add(n, std::memory_order_relaxed);
+        bucket_count[i].fetch_add(1, std::memory_order_relaxed);
+        bucket_bytes[i].fetch_add(n, std::memory_order_relaxed);
+        add_live(n);
+    }
+    void on_deallocate(size_t n)
+    {
+        deallocs.fetch_add(1, std::memory_order_relaxed);
+        live_bytes.fetch_sub(n, std::memory_order_relaxed);
+    }
+    void on_reallocate(size_t old_sz, size_t new_sz)
+    {
+        reallocs.fetch_add(1, std::memory_order_relaxed);
+        if (new_sz > old_sz) {
+            bytes_allocated.fetch_add(new_sz - old_sz, std::memory_order_relaxed);
+            add_live(new_sz - old_sz);
+        }
+        else {
+            live_bytes.fetch_sub(old_sz - new_sz, std::memory_order_relaxed);
+        }
+    }
+
+    alloc_stats_snapshot snapshot() const
+    {
+        alloc_stats_snapshot s;
+        s.allocs = allocs.load(std::memory_order_relaxed);
+        s.deallocs = deallocs.load(std::memory_order_relaxed);
+        s.reallocs = reallocs.load(std::memory_order_relaxed);
+        s.bytes_allocated = bytes_allocated.load(std::memory_order_relaxed);
+        s.live_bytes = live_bytes.load(std::memory_order_relaxed);
+        s.peak_bytes = peak_bytes.load(std::memory_order_relaxed);
+        for (int i = 0; i < __STATS_NBUCKETS; i++) {
+            s.bucket_count[i] = bucket_count[i].load(std::memory_order_relaxed);
+            s.bucket_bytes[i] = bucket_bytes[i].load(std::memory_order_relaxed);
+        }
+        return s;
+    }
+
+    /* 清零所有计数器，peak_bytes 从当前的 live_bytes 重新开始 */
+    void reset()
+    {
+        allocs = 0;
+        deallocs = 0;
+        reallocs = 0;
+        bytes_allocated = 0;
+        peak_bytes = live_bytes.load();
+        for (int i = 0; i < __STATS_NBUCKETS; i++) {
+            bucket_count[i] = 0;
+            bucket_bytes[i] = 0;
+        }
+    }
+};
+
+/* 包装配置器 Alloc，所有请求先记录再转交给 Alloc。
+ * 以私有继承持有 Alloc，Alloc 为空类时不占空间；Alloc 有状态时同样适用 */
+template <typename Alloc = default_alloc>
+class instrumented_alloc : private Alloc {
+private:
+    Alloc& base() { return *this; }
+
+public:
+    instrumented_alloc() {}
+    instrumented_alloc(const Alloc& a) : Alloc(a) {}
+
+    /* 每一种 Alloc 一份统计数据 */
+    static alloc_stats& stats()
+    {
+        static alloc_stats s;
+        return s;
+    }
+
+    void* allocate(size_t n)
+    {
+        stats().on_allocate(n);
+        return base().allocate(n);
+    }
+    void deallocate(void* p, size_t n)
+    {
+        stats().on_deallocate(n);
+        base().deallocate(p, n);
+    }
+    void* allocate(size_t n, size_t align)
+    {
+        stats().on_allocate(n);
+        return base().allocate(n, align);
+    }
+    void deallocate(void* p, size_t n, size_t align)
+    {
+        stats().on_deallocate(n);
+        base().deallocate(p, n, align);
+    }
+    void* reallocate(void* p, size_t old_sz, size_t new_sz)
+    {
+        stats().on_reallocate(old_sz, new_sz);
+        return base().reallocate(p, old_sz, new_sz);
+    }
+};
+
+/* instrumented_alloc 的 static 版本，Alloc 必须是只有 static 成员函数的配置器
+ * (malloc_alloc, default_alloc, thread_alloc)。统计数据记在 instrumented_alloc<Alloc>::stats() */
+template <typename Alloc = default_alloc>
+class static_instrumented_alloc {
+public:
+    static alloc_stats& stats() { return instrumented_alloc<Alloc>::stats(); }
+
+    static void* allocate(size_t n)
+    {
+        stats().on_allocate(n);
+        return Alloc::allocate(n);
+    }
+    static void deallocate(void* p, size_t n)
+    {
+        stats().on_deallocate(n);
+        Alloc::deallocate(p, n);
+    }
+    static void* allocate(size_t n, size_t align)
+    {
+        stats().on_allocate(n);
+        return Alloc::allocate(n, align);
+    }
+    static void deallocate(void* p, size_t n, size_t align)
+    {
+        stats().on_deallocate(n);
+        Alloc::deallocate(p, n, align);
+    }
+    static void* reallocate(void* p, size_t old_sz, size_t new_sz)
+    {
+        stats().on_reallocate(old_sz, new_sz);
+        return Alloc::reallocate(p, old_sz, new_sz);
+    }
+};
+
+}
+
+#endif
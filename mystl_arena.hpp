@@ -0,0 +1,145 @@
+/* file		: mystl_arena.hpp
+ * by		: waterlemon	429426523@qq.com
+ * date		: Sat 17 Oct 2026 11:02:37 AM CST
+ * last update	:
+ *
+ * description	: arena, arena_alloc
+ * arena 从大块 (block) 中顺序切出空间 (bump allocation)，
+ * 单个区块的 deallocate 什么也不做，所有空间由 release() 一次性归还。
+ * 适用于生命周期相同的一批短命容器:
+ *      arena a;
+ *      vector<int, arena_alloc> v((arena_alloc(a)));
+ *      list<int, arena_alloc>   l((arena_alloc(a)));
+ *      ...
+ *      a.release();        // 容器析构之后
+ */
+
+#ifndef     _MYSTL_ARENA_
+#define     _MYSTL_ARENA_
+
+#include "mystl_alloc.hpp"      /* malloc_alloc{}, __alloc_equal{}, __MAX_ALIGN */
+
+#include <cstring>              /* memcpy() */
+#include <cstddef>              /* size_t */
+
+namespace mystl
+{
+
+class arena {
+private:
+    /* 每个 block 的头部，之后是可供切分的空间 */
+    struct block {
+        block*  next;
+        size_t  size;           /* 包括 block 头部在内的大小 */
+    };
+
+    enum { __HEADER = (sizeof (block) + __MAX_ALIGN - 1) & ~(__MAX_ALIGN - 1) };
+
+    block*  blocks;             /* 已申请的 block 链表，最新的在前 */
+    char*   cur;                /* 当前 block 中下一次切分的位置 */
+    char*   end;                /* 当前 block 的尾 */
+    char*   last;               /* 最近一次配置的起始位置，供 reallocate() 原地扩展 */
+    size_t  block_size;
+
+    /* 禁止复制 */
+    arena(const arena&);
+    arena& operator= (const arena&);
+
+    static size_t align_up(size_t n, size_t align)
+        { return (n + align - 1) & ~(align - 1); }
+
+    void new_block(size_t n)
+    {
+        size_t sz = __HEADER + (n > block_size ? n : block_size);
+        block* b = (block*) malloc_alloc::allocate(sz);
+        b->next = blocks;
+        b->size = sz;
+        blocks = b;
+        cur = (char*) b + __HEADER;
+        end = (char*) b + sz;
+    }
+
+public:
+    explicit arena(size_t bsize = 64 * 1024)
+        : blocks(0), cur(0), end(0), last(0), block_size(bsize) {}
+    ~arena() { release(); }
+
+    /* align 必须是 2 的幂次 */
+    void* allocate(size_t n, size_t align = __MAX_ALIGN)
+    {
+        char* p = (char*) align_up((size_t) cur, align);
+        if (cur == 0 || p + n > end) {
+            new_block(n + align);
+            p = (char*) align_up((size_t) cur, align);
+        }
+        cur = p + n;
+        last = p;
+        return p;
+    }
+
+    void deallocate(void* /* p */, size_t /* n */) {}
+
+    /* 如果 p 是最近一次配置的区块，并且当前 block 还有空间，就原地扩展 */
+    void* reallocate(void* p, size_t old_sz, size_t new_sz)
+    {
+        if (p != 0 && p == last && (char*) p + new_sz <= end) {
+            cur = (char*) p + new_sz;
+            return p;
+        }
+        void* result = allocate(new_sz);
+        if (p != 0)
+            memcpy(result, p, old_sz < new_sz ? old_sz : new_sz);
+        return result;
+    }
+
+    /* 归还全部 block，之前配置的空间全部失效 */
+    void release()
+    {
+        while (blocks) {
+            block* next = blocks->next;
+            malloc_alloc::deallocate(blocks, blocks->size);
+            blocks = next;
+        }
+        cur = end = last = 0;
+    }
+
+    /* 已向系统申请的总量 */
+    size_t reserved() const
+    {
+        size_t total = 0;
+        for (block* b = blocks; b; b = b->next)
+            total += b->size;
+        return total;
+    }
+};
+
+/* arena_alloc 是有状态的配置器，只保存一个 arena 指针。
+ * 容器通过 __alloc_holder 持有它，同一个 arena 可以被多个容器共享 */
+class arena_alloc {
+private:
+    arena* a;
+
+public:
+    arena_alloc(arena& x) : a(&x) {}
+
+    void* allocate(size_t n) { return a->allocate(n); }
+    void* allocate(size_t n, size_t align) { return a->allocate(n, align); }
+    void  deallocate(void* p, size_t n) { a->deallocate(p, n); }
+    void  deallocate(void* p, size_t n, size_t /* align */) { a->deallocate(p, n); }
+    void* reallocate(void* p, size_t old_sz, size_t new_sz)
+        { return a->reallocate(p, old_sz, new_sz); }
+
+    arena* get_arena() const { return a; }
+
+    bool operator== (const arena_alloc& x) const { return a == x.a; }
+    bool operator!= (const arena_alloc& x) const { return a != x.a; }
+};
+
+template <>
+struct __alloc_equal<arena_alloc> {
+    static bool equal(const arena_alloc& a, const arena_alloc& b) { return a == b; }
+};
+
+}
+
+#endif
@@ -0,0 +1,204 @@
+/* file		: mystl_budget_alloc.hpp
+ * by		: waterlemon	429426523@qq.com
+ * date		: Sat 17 Oct 2026 05:06:51 PM CST
+ * last update	:
+ *
+ * description	: memory_budget, budget_alloc
+ * memory_budget 限定一组容器可以使用的字节数。超出预算时，
+ * 与 malloc_alloc 的 oom 处理相同: 调用登记的回收函数 (reclaim handler)，
+ * 例如让 cache 缩小，然后再试一次；回收函数无能为力时，
+ * budget_alloc 抛出 std::bad_alloc 交给调用者处理，而不是结束进程。
+ *      memory_budget budget(64 << 20);
+ *      budget.add_reclaim_handler(shrink_cache, &cache);
+ *      list<int, budget_alloc<> > l((budget_alloc<>(budget)));
+ */
+
+#ifndef     _MYSTL_BUDGET_ALLOC_
+#define     _MYSTL_BUDGET_ALLOC_
+
+#include "mystl_alloc.hpp"      /* alloc{}, __alloc_equal{} */
+
+#include <atomic>               /* std::atomic<> */
+#include <mutex>                /* std::mutex, std::lock_guard<> */
+#include <new>                  /* std::bad_alloc */
+#include <cstddef>              /* size_t */
+
+namespace mystl
+{
+
+enum { __BUDGET_MAX_HANDLERS = 16 };
+
+class memory_budget {
+public:
+    /* 回收函数: need 为超出预算的字节数，返回实际归还的字节数 (0 表示无能为力) */
+    typedef size_t (*reclaim_handler)(size_t need, void* arg);
+
+private:
+    struct handler_entry {
+        reclaim_handler f;
+        void*           arg;
+    };
+
+    std::atomic<size_t> used_bytes;
+    std::atomic<size_t> limit_bytes;
+
+    std::mutex          handler_lock;
+    handler_entry       handlers[__BUDGET_MAX_HANDLERS];
+    int                 nhandlers;
+
+    /* 禁止复制 */
+    memory_budget(const memory_budget&);
+    memory_budget& operator= (const memory_budget&);
+
+    /* 依次调用回收函数。回收函数内部可能再次配置或释放空间，
+     * 所以先复制一份，不在持有锁的时候调用 */
+    size_t reclaim(size_t need)
+    {
+        handler_entry copy[__BUDGET_MAX_HANDLERS];
+        int n;
+        {
+            std::lock_guard<std::mutex> guard(handler_lock);
+            n = nhandlers;
+            for (int i = 0; i < n; i++)
+                copy[i] = handlers[i];
+        }
+        size_t freed = 0;
+        for (int i = 0; i < n && freed < need; i++)
+            freed += copy[i].f(need - freed, copy[i].arg);
+        return freed;
+    }
+
+public:
+    explicit memory_budget(size_t limit) : used_bytes(0), limit_bytes(limit), nhandlers(0) {}
+
+    size_t used() const { return used_bytes.load(std::memory_order_relaxed); }
+    size_t limit() const { return limit_bytes.load(std::memory_order_relaxed); }
+    void set_limit(size_t limit) { limit_bytes.store(limit, std::memory_order_relaxed); }
+
+    /* 登记回收函数，最多 __BUDGET_MAX_HANDLERS 个，登记失败返回 false */
+    bool add_reclaim_handler(reclaim_handler f, void* arg = 0)
+    {
+        std::lock_guard<std::mutex> guard(handler_lock);
+        if (nhandlers == __BUDGET_MAX_HANDLERS)
+            return false;
+        handlers[nhandlers].f = f;
+        handlers[nhandlers].arg = arg;
+        ++nhandlers;
+        return true;
+    }
+    void remove_reclaim_handler(reclaim_handler f, void* arg = 0)
+    {
+        std::lock_guard<std::mutex> guard(handler_lock);
+        for (int i = 0; i < nhandlers; i++) {
+            if (handlers[i].f == f && handlers[i].arg == arg) {
+                handlers[i] = handlers[--nhandlers];
+                return;
+            }
+        }
+    }
+
+    /* 预留 n 个字节。超出预算时调用一轮回收函数后再试一次，仍然不够时返回 false。
+     * 只回收一轮: 回收函数报告的字节数未必使 used_bytes 下降 (例如归还的空间不属于本预算)，
+     * 反复重试可能永远不会结束。
+     * 以 cur <= lim - n 判断，不计算 cur + n，n 很大时也不会溢出 */
+    bool acquire(size_t n)
+    {
+        for (int pass = 0; ; pass++) {
+            size_t cur = used_bytes.load(std::memory_order_relaxed);
+            size_t lim = limit();
+            if (n > lim)
+                return false;       /* 整个预算都放不下，回收也没有用 */
+            while (cur <= lim - n) {
+                if (used_bytes.compare_exchange_weak(cur, cur + n,
+                            std::memory_order_relaxed))
+                    return true;
+            }
+            if (pass == 1 || reclaim(cur - (lim - n)) == 0)
+                return false;
+        }
+    }
+
+    void release(size_t n) { used_bytes.fetch_sub(n, std::memory_order_relaxed); }
+};
+
+/* budget_alloc 把 Alloc 的配置记入 memory_budget。
+ * 以私有继承持有 Alloc，Alloc 为空类时只多一个 memory_budget 指针 */
+template <typename Alloc = alloc>
+class budget_alloc : private Alloc {
+private:
+    memory_budget* b;
+
+    Alloc& base() { return *this; }
+
+    void acquire(size_t n)
+    {
+        if (!b->acquire(n))
+            throw std::bad_alloc();
+    }
+
+public:
+    budget_alloc(memory_budget& x) : b(&x) {}
+    budget_alloc(memory_budget& x, const Alloc& a) : Alloc(a), b(&x) {}
+
+    /* 超出预算且无法回收时抛出 std::bad_alloc，容器的状态保持不变 */
+    void* allocate(size_t n)
+    {
+        acquire(n);
+        try {
+            return base().allocate(n);
+        } catch (...) {
+            b->release(n);
+            throw;
+        }
+    }
+    void* allocate(size_t n, size_t align)
+    {
+        acquire(n);
+        try {
+            return base().allocate(n, align);
+        } catch (...) {
+            b->release(n);
+            throw;
+        }
+    }
+    void deallocate(void* p, size_t n)
+    {
+        base().deallocate(p, n);
+        b->release(n);
+    }
+    void deallocate(void* p, size_t n, size_t align)
+    {
+        base().deallocate(p, n, align);
+        b->release(n);
+    }
+    void* reallocate(void* p, size_t old_sz, size_t new_sz)
+    {
+        if (new_sz > old_sz)
+            acquire(new_sz - old_sz);
+        void* result;
+        try {
+            result = base().reallocate(p, old_sz, new_sz);
+        } catch (...) {
+            if (new_sz > old_sz)
+                b->release(new_sz - old_sz);
+            throw;
+        }
+        if (new_sz < old_sz)
+            b->release(old_sz - new_sz);
+        return result;
+    }
+
+    memory_budget* budget() const { return b; }
+
+    bool operator== (const budget_alloc& x) const { return b == x.b; }
+    bool operator!= (const budget_alloc& x) const { return b != x.b; }
+};
+
+template <typename Alloc>
+struct __alloc_equal<budget_alloc<Alloc> > {
+    static bool equal(const budget_alloc<Alloc>& a, const budget_alloc<Alloc>& b) { return a == b; }
+};
+
+}
+
+#endif
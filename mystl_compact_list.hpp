@@ -0,0 +1,472 @@
+/* file		: mystl_compact_list.hpp
+ * by		: waterlemon	429426523@qq.com
+ * date		: Sun 18 Oct 2026 06:25:09 PM CST
+ * last update	:
+ *
+ * description	: compact_list
+ * compact_list 的结点都放在一个 vector 中，以 32 位的下标代替指针互相链接。
+ * 64 位系统上 list 的每个结点有 16 字节的指针，另外各自配置；
+ * compact_list<int> 的结点只有 12 字节，而且在内存中连续，遍历时局部性较好。
+ * 删除的结点放进以下标串成的 free-list，之后插入时重复使用。
+ *      compact_list<int> l;
+ *      l.reserve(1000);            // 预先配置结点
+ *      l.push_back(1);
+ *
+ * 迭代器记住所属的 compact_list 与结点下标，所以 vector 扩充空间之后迭代器仍然有效，
+ * 只有指向被删除元素的迭代器失效；但指向元素的引用与指针在扩充之后失效。
+ * 最多 __COMPACT_LIST_MAX 个元素。
+ */
+
+#ifndef     _MYSTL_COMPACT_LIST_
+#define     _MYSTL_COMPACT_LIST_
+
+#include "mystl_alloc.hpp"      /* alloc{} */
+#include "mystl_iterator.hpp"   /* bidirectional_iterator_tag{} */
+#include "mystl_construct.hpp"  /* construct(), destroy() */
+#include "mystl_type_traits.hpp"    /* __type_traits{} */
+#include "mystl_vector.hpp"     /* vector{} */
+#include "mystl_list.hpp"       /* __list_less{}, __list_equal_to{} */
+
+#include <cstddef>              /* size_t, ptrdiff_t */
+#include <cstdint>              /* uint32_t */
+#include <stdexcept>            /* std::length_error */
+#include <utility>              /* std::move(), std::forward(), std::swap() */
+#include <type_traits>          /* std::aligned_storage<>, std::is_nothrow_move_constructible<> */
+
+namespace mystl
+{
+
+enum { __COMPACT_LIST_NIL = 0xffffffffu };      /* 空链接，也是 end() 的下标 */
+enum { __COMPACT_LIST_FREE = 0xfffffffeu };     /* 在 free-list 上的结点的 prev */
+enum { __COMPACT_LIST_MAX = 0xfffffffeu };      /* 结点个数的上限 */
+
+/* compact_list结点: __compact_list_node
+ * 在 free-list 上的结点没有元素。结点的复制、移动与析构只处理有元素的结点，
+ * 于是 vector 扩充空间时可以像一般的元素一样搬移结点 */
+template <typename T>
+struct __compact_list_node {
+    uint32_t prev;
+    uint32_t next;
+    typename std::aligned_storage<sizeof (T), alignof(T)>::type buf;
+
+    T& value() { return *(T*) &buf; }
+    const T& value() const { return *(const T*) &buf; }
+    bool is_free() const { return prev == (uint32_t) __COMPACT_LIST_FREE; }
+
+    template <typename... Args>
+    __compact_list_node(uint32_t p, uint32_t n, Args&&... args) : prev(p), next(n)
+    {
+        mystl::construct(&value(), std::forward<Args>(args)...);
+    }
+    __compact_list_node(const __compact_list_node& x) : prev(x.prev), next(x.next)
+    {
+        if (!is_free())
+            mystl::construct(&value(), x.value());
+    }
+    __compact_list_node(__compact_list_node&& x)
+        noexcept(std::is_nothrow_move_constructible<T>::value)
+        : prev(x.prev), next(x.next)
+    {
+        if (!is_free())
+            mystl::construct(&value(), std::move(x.value()));
+    }
+    /* vector::clear() 等操作会对结点赋值 */
+    __compact_list_node& operator= (const __compact_list_node& x)
+    {
+        if (this != &x) {
+            if (!is_free())
+                mystl::destroy(&value());
+            prev = __COMPACT_LIST_FREE;     /* 构造失败时仍然是一个空结点 */
+            if (!x.is_free())
+                mystl::construct(&value(), x.value());
+            prev = x.prev;
+            next = x.next;
+        }
+        return *this;
+    }
+    __compact_list_node& operator= (__compact_list_node&& x)
+    {
+        if (this != &x) {
+            if (!is_free())
+                mystl::destroy(&value());
+            prev = __COMPACT_LIST_FREE;     /* 构造失败时仍然是一个空结点 */
+            if (!x.is_free())
+                mystl::construct(&value(), std::move(x.value()));
+            prev = x.prev;
+            next = x.next;
+        }
+        return *this;
+    }
+    ~__compact_list_node()
+    {
+        if (!is_free())
+            mystl::destroy(&value());
+    }
+};
+
+/* 结点能否逐字节搬移、能否不析构，都与元素相同 */
+template <typename T>
+struct __type_traits<__compact_list_node<T> > {
+    typedef __false_type    has_trivial_default_constructor;
+    typedef __false_type    has_trivial_copy_constructor;
+    typedef __false_type    has_trivial_assignment_operator;
+    typedef typename __type_traits<T>::has_trivial_destructor   has_trivial_destructor;
+    typedef __false_type    is_POD_type;
+    typedef typename __type_traits<T>::is_trivially_relocatable is_trivially_relocatable;
+};
+
+/* compact_list迭代器: __compact_list_iterator
+ * 下标要通过所属的 compact_list 才能找到结点 */
+template <typename T, typename List, typename Ref, typename Ptr>
+struct __compact_list_iterator {
+    typedef __compact_list_iterator<T, List, T&, T*>    iterator;
+    typedef __compact_list_iterator<T, List, Ref, Ptr>  self;
+
+    typedef bidirectional_iterator_tag      iterator_category;
+    typedef T                               value_type;
+    typedef Ptr                             pointer;
+    typedef Ref                             reference;
+    typedef ptrdiff_t                       difference_type;
+    typedef size_t                          size_type;
+
+    List*       owner;
+    uint32_t    index;
+
+    __compact_list_iterator(List* l, uint32_t i) : owner(l), index(i) {}
+    __compact_list_iterator() : owner(0), index(__COMPACT_LIST_NIL) {}
+    __compact_list_iterator(const iterator& x) : owner(x.owner), index(x.index) {}
+
+    bool operator== (const self& x) const { return index == x.index; }
+    bool operator!= (const self& x) const { return index != x.index; }
+
+    reference operator* () const { return owner->nodes[index].value(); }
+    pointer operator-> () const { return &(operator*()); }
+
+    self& operator++ ()
+    {
+        index = owner->next_of(index);
+        return *this;
+    }
+    self operator++ (int)
+    {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+    self& operator-- ()
+    {
+        index = owner->prev_of(index);
+        return *this;
+    }
+    self operator-- (int)
+    {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+};
+
+/* 与 list 一样是环形链表: 下标 __COMPACT_LIST_NIL 代表头结点，它的链接另外存放 */
+template <typename T, typename Alloc = alloc>
+class compact_list {
+public:
+    typedef T                               value_type;
+    typedef T*                              pointer;
+    typedef T&                              reference;
+    typedef const T&                        const_reference;
+    typedef ptrdiff_t                       difference_type;
+    typedef size_t                          size_type;
+    typedef __compact_list_iterator<T, compact_list, T&, T*> iterator;
+    typedef Alloc                           allocator_type;
+
+protected:
+    typedef __compact_list_node<T>          list_node;
+
+    template <typename, typename, typename, typename>
+    friend struct __compact_list_iterator;
+
+    vector<list_node, Alloc> nodes;
+    uint32_t    head_prev;      /* 最后一个结点 */
+    uint32_t    head_next;      /* 第一个结点 */
+    uint32_t    free_head;      /* free-list 的第一个结点 */
+    size_type   length;         /* 元素个数 */
+
+    uint32_t& next_of(uint32_t i) { return i == (uint32_t) __COMPACT_LIST_NIL ? head_next : nodes[i].next; }
+    uint32_t& prev_of(uint32_t i) { return i == (uint32_t) __COMPACT_LIST_NIL ? head_prev : nodes[i].prev; }
+
+    void empty_initialize()
+    {
+        head_prev = head_next = __COMPACT_LIST_NIL;
+        free_head = __COMPACT_LIST_NIL;
+        length = 0;
+    }
+
+    /* 取得一个以 args 构造了元素的结点: 先用 free-list 上的结点，没有时在 vector 尾端添加。
+     * 返回的结点还没有接入链表 */
+    template <typename... Args>
+    uint32_t create_node(Args&&... args)
+    {
+        uint32_t i = free_head;
+        if (i != (uint32_t) __COMPACT_LIST_NIL) {
+            mystl::construct(&nodes[i].value(), std::forward<Args>(args)...);
+            free_head = nodes[i].next;
+            nodes[i].prev = __COMPACT_LIST_NIL;
+        }
+        else {
+            if (nodes.size() >= (size_type) __COMPACT_LIST_MAX)
+                throw std::length_error("compact_list: too many elements");
+            i = (uint32_t) nodes.size();
+            nodes.emplace_back(__COMPACT_LIST_NIL, __COMPACT_LIST_NIL,
+                    std::forward<Args>(args)...);
+        }
+        return i;
+    }
+    /* 析构元素，结点放进 free-list */
+    void destroy_node(uint32_t i)
+    {
+        mystl::destroy(&nodes[i].value());
+        nodes[i].prev = __COMPACT_LIST_FREE;
+        nodes[i].next = free_head;
+        free_head = i;
+    }
+
+    /* 把结点 i 接在 position 之前 */
+    void link_before(uint32_t position, uint32_t i)
+    {
+        uint32_t prev = prev_of(position);
+        nodes[i].next = position;
+        nodes[i].prev = prev;
+        next_of(prev) = i;
+        prev_of(position) = i;
+    }
+    void unlink(uint32_t i)
+    {
+        next_of(nodes[i].prev) = nodes[i].next;
+        prev_of(nodes[i].next) = nodes[i].prev;
+    }
+
+    /* 把 x 的元素依次接在尾端，结点按链表顺序排列 */
+    void append(const compact_list& x)
+    {
+        for (uint32_t i = x.head_next; i != (uint32_t) __COMPACT_LIST_NIL; i = x.nodes[i].next)
+            push_back(x.nodes[i].value());
+    }
+
+    /* 合并两条以 __COMPACT_LIST_NIL 结尾、已排序的单向链 (只看 next)，与 list 相同 */
+    template <typename Compare>
+    uint32_t merge_chains(uint32_t a, uint32_t b, Compare comp)
+    {
+        uint32_t result;
+        uint32_t* tail = &result;
+        while (a != (uint32_t) __COMPACT_LIST_NIL && b != (uint32_t) __COMPACT_LIST_NIL) {
+            if (comp(nodes[b].value(), nodes[a].value())) {
+                *tail = b;
+                tail = &nodes[b].next;
+                b = nodes[b].next;
+            }
+            else {
+                *tail = a;
+                tail = &nodes[a].next;
+                a = nodes[a].next;
+            }
+        }
+        *tail = a != (uint32_t) __COMPACT_LIST_NIL ? a : b;
+        return result;
+    }
+
+public:
+    iterator begin() { return iterator(this, head_next); }
+    iterator end() { return iterator(this, __COMPACT_LIST_NIL); }
+    size_type size() { return length; }
+    bool empty() { return length == 0; }
+    reference front() { return nodes[head_next].value(); }
+    reference back() { return nodes[head_prev].value(); }
+
+    Alloc get_allocator() const { return nodes.get_allocator(); }
+
+public:
+    compact_list() { empty_initialize(); }
+    explicit compact_list(const Alloc& a) : nodes(a) { empty_initialize(); }
+    compact_list(size_type n, const T& value, const Alloc& a = Alloc()) : nodes(a)
+    {
+        empty_initialize();
+        reserve(n);
+        while (n--)
+            push_back(value);
+    }
+    /* 复制时按链表顺序重新排列结点，不复制 free-list */
+    compact_list(const compact_list& x) : nodes(x.get_allocator())
+    {
+        empty_initialize();
+        reserve(x.length);
+        append(x);
+    }
+    compact_list(compact_list&& x) : nodes(x.get_allocator())
+    {
+        empty_initialize();
+        swap(x);
+    }
+    compact_list& operator= (const compact_list& x)
+    {
+        if (this != &x) {
+            clear();
+            reserve(x.length);
+            append(x);
+        }
+        return *this;
+    }
+    compact_list& operator= (compact_list&& x)
+    {
+        if (this != &x) {
+            clear();
+            swap(x);
+        }
+        return *this;
+    }
+
+    /* 交换之后迭代器仍然指向原来的 compact_list */
+    void swap(compact_list& x) noexcept
+    {
+        nodes.swap(x.nodes);
+        std::swap(head_prev, x.head_prev);
+        std::swap(head_next, x.head_next);
+        std::swap(free_head, x.free_head);
+        std::swap(length, x.length);
+    }
+
+    /* 预先配置 n 个结点的空间，之后 n 个元素以内的插入不会使引用失效 */
+    void reserve(size_type n)
+    {
+        if (n > nodes.size())
+            nodes.reserve(n);
+    }
+    size_type capacity() { return nodes.capacity(); }
+
+public:
+    void push_back(const T& x) { emplace(end(), x); }
+    void push_back(T&& x) { emplace(end(), std::move(x)); }
+    void push_front(const T& x) { emplace(begin(), x); }
+    void push_front(T&& x) { emplace(begin(), std::move(x)); }
+    template <typename... Args>
+    void emplace_back(Args&&... args) { emplace(end(), std::forward<Args>(args)...); }
+    template <typename... Args>
+    void emplace_front(Args&&... args) { emplace(begin(), std::forward<Args>(args)...); }
+
+    iterator insert(iterator position, const T& x) { return emplace(position, x); }
+    iterator insert(iterator position, T&& x) { return emplace(position, std::move(x)); }
+    /* 在 position 之前以 args 构造一个元素 */
+    template <typename... Args>
+    iterator emplace(iterator position, Args&&... args)
+    {
+        uint32_t i = create_node(std::forward<Args>(args)...);
+        link_before(position.index, i);
+        ++length;
+        return iterator(this, i);
+    }
+
+    iterator erase(iterator position)
+    {
+        if (position == end())
+            return position;
+        uint32_t next = nodes[position.index].next;
+        unlink(position.index);
+        destroy_node(position.index);
+        --length;
+        return iterator(this, next);
+    }
+    iterator erase(iterator first, iterator last)
+    {
+        while (first != last)
+            first = erase(first);
+        return last;
+    }
+    void pop_front() { erase(begin()); }
+    void pop_back() { erase(iterator(this, head_prev)); }
+
+    /* 析构所有元素，结点的空间保留下来 */
+    void clear()
+    {
+        nodes.clear();
+        empty_initialize();
+    }
+
+public:
+    /* 逆置: 交换每个结点 (包括头结点) 的 prev 与 next */
+    void reverse()
+    {
+        for (uint32_t i = head_next; i != (uint32_t) __COMPACT_LIST_NIL; ) {
+            uint32_t next = nodes[i].next;
+            std::swap(nodes[i].prev, nodes[i].next);
+            i = next;
+        }
+        std::swap(head_prev, head_next);
+    }
+
+    /* 删除连续而相同的元素，只留第一个 */
+    void unique() { unique(__list_equal_to()); }
+    template <typename BinaryPredicate>
+    void unique(BinaryPredicate pred)
+    {
+        iterator first = begin(), last = end();
+        if (first == last)
+            return;
+        iterator next = first;
+        while (++next != last) {
+            if (pred(*first, *next))
+                erase(next);
+            else
+                first = next;
+            next = first;
+        }
+    }
+
+    /* 与 list::sort() 相同的 bottom-up merge sort，只改变下标，不搬移元素 */
+    void sort() { sort(__list_less()); }
+    template <typename Compare>
+    void sort(Compare comp)
+    {
+        if (length < 2)
+            return;
+
+        uint32_t bins[32];
+        int fill = 0;
+        uint32_t node = head_next;
+        while (node != (uint32_t) __COMPACT_LIST_NIL) {
+            uint32_t carry = node;
+            node = nodes[node].next;
+            nodes[carry].next = __COMPACT_LIST_NIL;
+            int i = 0;
+            for (; i < fill && bins[i] != (uint32_t) __COMPACT_LIST_NIL; i++) {
+                carry = merge_chains(bins[i], carry, comp);
+                bins[i] = __COMPACT_LIST_NIL;
+            }
+            bins[i] = carry;
+            if (i == fill)
+                ++fill;
+        }
+        uint32_t result = __COMPACT_LIST_NIL;
+        for (int i = 0; i < fill; i++) {
+            if (bins[i] != (uint32_t) __COMPACT_LIST_NIL)
+                result = result != (uint32_t) __COMPACT_LIST_NIL ?
+                    merge_chains(bins[i], result, comp) : bins[i];
+        }
+
+        uint32_t prev = __COMPACT_LIST_NIL;
+        for (uint32_t p = result; p != (uint32_t) __COMPACT_LIST_NIL; p = nodes[p].next) {
+            nodes[p].prev = prev;
+            next_of(prev) = p;
+            prev = p;
+        }
+        head_prev = prev;
+    }
+};
+
+template <typename T, typename Alloc>
+inline void swap(compact_list<T, Alloc>& x, compact_list<T, Alloc>& y) noexcept
+{
+    x.swap(y);
+}
+
+}
+
+#endif
@@ -10,16 +10,20 @@
 #define     _MYSTL_CONSTRUCT_
 
 #include <new>
+#include <utility>                  /* std::forward() */
 #include "mystl_iterator.hpp"       /* value_type() */
 #include "mystl_type_traits.hpp"    /* __false_type{}, __type_traits<>{} */
 
 namespace mystl
 {
 
-template <typename T1, typename T2>
-inline void construct(T1* p, const T2& value)
+/* 以 args 为参数在 p 处构造 T1 对象，参数以完美转发传给构造函数:
+ * construct(p, x) 复制构造，construct(p, std::move(x)) 移动构造，
+ * construct(p) 值初始化 */
+template <typename T1, typename... Args>
+inline void construct(T1* p, Args&&... args)
 {
-    new (p) T1(value);  // placement new
+    new (p) T1(std::forward<Args>(args)...);  // placement new
 }
 
 template <typename T>
@@ -49,7 +53,7 @@ template <typename ForwardIterator>
 inline void __destroy_aux(ForwardIterator first, ForwardIterator last, __false_type)
 {
     for (; first != last; ++first)
-        destroy(&*first);
+        mystl::destroy(&*first);
 }
 
 /* 如果元素的型别有 trivial destructor */
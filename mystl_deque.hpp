@@ -0,0 +1,620 @@
+/* file		: mystl_deque.hpp
+ * by		: waterlemon	429426523@qq.com
+ * date		: Sun 18 Oct 2026 11:36:08 AM CST
+ * last update	:
+ *
+ * description	: deque
+ * deque 由一段一段定量的连续空间 (缓冲区, buffer) 构成，
+ * 一小块连续空间 map 存放各个缓冲区的地址，作为中控。
+ * 在头尾两端增加元素只需要在 map 的两端接上新的缓冲区，已有元素不会搬移，
+ * 指向已有元素的引用与指针在 push_front/push_back 之后仍然有效。
+ */
+
+#ifndef     _MYSTL_DEQUE_
+#define     _MYSTL_DEQUE_
+
+#include "mystl_alloc.hpp"      /* simple_alloc{}, alloc{}, __alloc_holder{} */
+#include "mystl_iterator.hpp"   /* random_access_iterator_tag{} */
+#include "mystl_construct.hpp"  /* construct(), destroy() */
+#include "mystl_algobase.hpp"   /* copy(), move(), move_backward(), max() */
+#include "mystl_uninitialized.hpp"  /* uninitialized_fill(), uninitialized_copy() */
+
+#include <cstddef>              /* size_t, ptrdiff_t */
+#include <utility>              /* std::move(), std::forward(), std::swap() */
+
+namespace mystl
+{
+
+enum { __DEQUE_BUF_BYTES = 512 };       /* 缓冲区的大小 */
+enum { __DEQUE_INITIAL_MAP_SIZE = 8 };  /* map 最少管理的缓冲区个数 */
+
+/* 每个缓冲区容纳的元素个数: 元素不大于 __DEQUE_BUF_BYTES 时填满缓冲区，否则只放一个 */
+inline size_t __deque_buf_size(size_t sz)
+{
+    return sz < (size_t) __DEQUE_BUF_BYTES ? (size_t) __DEQUE_BUF_BYTES / sz : 1;
+}
+
+/* deque迭代器: __deque_iterator
+ * 除了指向当前元素，还要记住所在缓冲区的边界与 map 中的位置 */
+template <typename T, typename Ref, typename Ptr>
+struct __deque_iterator {
+    typedef __deque_iterator<T, T&, T*>     iterator;
+    typedef __deque_iterator<T, Ref, Ptr>   self;
+
+    typedef random_access_iterator_tag      iterator_category;
+    typedef T                               value_type;
+    typedef Ptr                             pointer;
+    typedef Ref                             reference;
+    typedef ptrdiff_t                       difference_type;
+    typedef size_t                          size_type;
+    typedef T**                             map_pointer;
+
+    T* cur;             /* 当前元素 */
+    T* first;           /* 所在缓冲区的头 */
+    T* last;            /* 所在缓冲区的尾 (含备用空间) */
+    map_pointer node;   /* 指向 map 中管理本缓冲区的位置 */
+
+    static size_t buffer_size() { return __deque_buf_size(sizeof (T)); }
+
+    __deque_iterator() : cur(0), first(0), last(0), node(0) {}
+    __deque_iterator(T* x, map_pointer y)
+        : cur(x), first(*y), last(*y + buffer_size()), node(y) {}
+    __deque_iterator(const iterator& x)
+        : cur(x.cur), first(x.first), last(x.last), node(x.node) {}
+
+    /* 跳到另一个缓冲区 */
+    void set_node(map_pointer new_node)
+    {
+        node = new_node;
+        first = *new_node;
+        last = first + difference_type(buffer_size());
+    }
+
+    reference operator* () const { return *cur; }
+    pointer operator-> () const { return &(operator*()); }
+
+    difference_type operator- (const self& x) const
+    {
+        return difference_type(buffer_size()) * (node - x.node - 1) +
+            (cur - first) + (x.last - x.cur);
+    }
+
+    self& operator++ ()
+    {
+        ++cur;
+        if (cur == last) {
+            set_node(node + 1);
+            cur = first;
+        }
+        return *this;
+    }
+    self operator++ (int)
+    {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+    self& operator-- ()
+    {
+        if (cur == first) {
+            set_node(node - 1);
+            cur = last;
+        }
+        --cur;
+        return *this;
+    }
+    self operator-- (int)
+    {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    /* 随机存取: 目标在同一缓冲区内时直接移动，否则先跳到目标缓冲区 */
+    self& operator+= (difference_type n)
+    {
+        difference_type offset = n + (cur - first);
+        if (offset >= 0 && offset < difference_type(buffer_size()))
+            cur += n;
+        else {
+            difference_type node_offset = offset > 0 ?
+                offset / difference_type(buffer_size()) :
+                -difference_type((-offset - 1) / buffer_size()) - 1;
+            set_node(node + node_offset);
+            cur = first + (offset - node_offset * difference_type(buffer_size()));
+        }
+        return *this;
+    }
+    self operator+ (difference_type n) const
+    {
+        self tmp = *this;
+        return tmp += n;
+    }
+    self& operator-= (difference_type n) { return *this += -n; }
+    self operator- (difference_type n) const
+    {
+        self tmp = *this;
+        return tmp -= n;
+    }
+    reference operator[] (difference_type n) const { return *(*this + n); }
+
+    bool operator== (const self& x) const { return cur == x.cur; }
+    bool operator!= (const self& x) const { return !(*this == x); }
+    bool operator< (const self& x) const
+    {
+        return node == x.node ? cur < x.cur : node < x.node;
+    }
+};
+
+template <typename T, typename Alloc = alloc>
+class deque : protected __alloc_holder<Alloc> {
+public:
+    typedef T                               value_type;
+    typedef T*                              pointer;
+    typedef T&                              reference;
+    typedef const T&                        const_reference;
+    typedef ptrdiff_t                       difference_type;
+    typedef size_t                          size_type;
+    typedef __deque_iterator<T, T&, T*>     iterator;
+    typedef Alloc                           allocator_type;
+
+protected:
+    typedef __alloc_holder<Alloc>           alloc_base;
+    typedef pointer*                        map_pointer;
+    typedef simple_alloc<value_type, Alloc> data_allocator;
+    typedef simple_alloc<pointer, Alloc>    map_allocator;
+
+    iterator    start;          /* 第一个元素 */
+    iterator    finish;         /* 最后一个元素的下一个位置 */
+    map_pointer map;            /* 中控器，每个元素指向一个缓冲区 */
+    size_type   map_size;       /* map 内的指针个数 */
+
+    static size_type buffer_size() { return __deque_buf_size(sizeof (T)); }
+
+    pointer allocate_node() { return data_allocator::allocate(this->allocator(), buffer_size()); }
+    void deallocate_node(pointer p) { data_allocator::deallocate(this->allocator(), p, buffer_size()); }
+
+public:
+    iterator begin() { return start; }
+    iterator end() { return finish; }
+    size_type size() { return size_type(finish - start); }
+    bool empty() { return finish == start; }
+    reference operator[] (size_type n) { return start[difference_type(n)]; }
+    reference front() { return *start; }
+    reference back()
+    {
+        iterator tmp = finish;
+        --tmp;
+        return *tmp;
+    }
+
+    using alloc_base::get_allocator;
+
+public:
+    deque() : map(0), map_size(0) { create_map_and_nodes(0); }
+    explicit deque(const Alloc& a) : alloc_base(a), map(0), map_size(0)
+        { create_map_and_nodes(0); }
+    deque(size_type n, const T& value, const Alloc& a = Alloc())
+        : alloc_base(a), map(0), map_size(0)
+        { fill_initialize(n, value); }
+    deque(int n, const T& value, const Alloc& a = Alloc())
+        : alloc_base(a), map(0), map_size(0)
+        { fill_initialize(n, value); }
+    deque(long n, const T& value, const Alloc& a = Alloc())
+        : alloc_base(a), map(0), map_size(0)
+        { fill_initialize(n, value); }
+    explicit deque(size_type n, const Alloc& a = Alloc())
+        : alloc_base(a), map(0), map_size(0)
+        { fill_initialize(n, T()); }
+    deque(const deque& x) : alloc_base(x.get_allocator()), map(0), map_size(0)
+    {
+        create_map_and_nodes(x.finish - x.start);
+        try {
+            mystl::uninitialized_copy(x.start, x.finish, start);
+        } catch (...) {
+            destroy_map_and_nodes();
+            throw;
+        }
+    }
+    /* 移动构造: 接管 x 的 map，x 重新建立一个空的 map */
+    deque(deque&& x) : alloc_base(x.get_allocator()), map(0), map_size(0)
+    {
+        create_map_and_nodes(0);
+        swap(x);
+    }
+    deque& operator= (const deque& x)
+    {
+        if (this != &x) {
+            const size_type len = size();
+            if (len >= size_type(x.finish - x.start))
+                erase(mystl::copy(x.start, x.finish, start), finish);
+            else {
+                iterator mid = x.start + difference_type(len);
+                mystl::copy(x.start, mid, start);
+                for (; mid != x.finish; ++mid)
+                    push_back(*mid);
+            }
+        }
+        return *this;
+    }
+    deque& operator= (deque&& x)
+    {
+        if (this != &x) {
+            clear();
+            swap(x);
+        }
+        return *this;
+    }
+    ~deque()
+    {
+        mystl::destroy(start, finish);
+        destroy_map_and_nodes();
+    }
+
+    /* 交换两个 deque 的 map 与配置器，不复制任何元素 */
+    void swap(deque& x) noexcept
+    {
+        std::swap(this->allocator(), x.allocator());
+        std::swap(start, x.start);
+        std::swap(finish, x.finish);
+        std::swap(map, x.map);
+        std::swap(map_size, x.map_size);
+    }
+
+public:
+    void push_back(const T& x) { emplace_back(x); }
+    void push_back(T&& x) { emplace_back(std::move(x)); }
+    void push_front(const T& x) { emplace_front(x); }
+    void push_front(T&& x) { emplace_front(std::move(x)); }
+
+    template <typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        if (finish.cur != finish.last - 1) {    /* 最后一个缓冲区还有两个以上的备用空间 */
+            mystl::construct(finish.cur, std::forward<Args>(args)...);
+            ++finish.cur;
+        }
+        else
+            emplace_back_aux(std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    void emplace_front(Args&&... args)
+    {
+        if (start.cur != start.first) {         /* 第一个缓冲区还有备用空间 */
+            mystl::construct(start.cur - 1, std::forward<Args>(args)...);
+            --start.cur;
+        }
+        else
+            emplace_front_aux(std::forward<Args>(args)...);
+    }
+
+    void pop_back()
+    {
+        if (finish.cur != finish.first) {
+            --finish.cur;
+            mystl::destroy(finish.cur);
+        }
+        else
+            pop_back_aux();
+    }
+    void pop_front()
+    {
+        if (start.cur != start.last - 1) {
+            mystl::destroy(start.cur);
+            ++start.cur;
+        }
+        else
+            pop_front_aux();
+    }
+
+    /* 只保留一个缓冲区 */
+    void clear();
+
+    iterator erase(iterator pos)
+    {
+        iterator next = pos;
+        ++next;
+        difference_type index = pos - start;
+        if (size_type(index) < (size() >> 1)) {     /* 前面的元素较少，移动前面的 */
+            mystl::move_backward(start, pos, next);
+            pop_front();
+        }
+        else {
+            mystl::move(next, finish, pos);
+            pop_back();
+        }
+        return start + index;
+    }
+    iterator erase(iterator first, iterator last);
+
+    iterator insert(iterator position, const T& x) { return emplace(position, x); }
+    iterator insert(iterator position, T&& x) { return emplace(position, std::move(x)); }
+    template <typename... Args>
+    iterator emplace(iterator position, Args&&... args)
+    {
+        if (position.cur == start.cur) {
+            emplace_front(std::forward<Args>(args)...);
+            return start;
+        }
+        else if (position.cur == finish.cur) {
+            emplace_back(std::forward<Args>(args)...);
+            iterator tmp = finish;
+            --tmp;
+            return tmp;
+        }
+        else
+            return insert_aux(position, T(std::forward<Args>(args)...));
+    }
+
+    void resize(size_type new_size, const T& x)
+    {
+        const size_type len = size();
+        if (new_size < len)
+            erase(start + difference_type(new_size), finish);
+        else {
+            const T x_copy = x;
+            for (size_type i = len; i < new_size; i++)
+                push_back(x_copy);
+        }
+    }
+    void resize(size_type new_size) { resize(new_size, T()); }
+
+protected:
+    void create_map_and_nodes(size_type num_elements);
+    void destroy_map_and_nodes();
+    void fill_initialize(size_type n, const T& value);
+
+    template <typename... Args>
+    void emplace_back_aux(Args&&... args);
+    template <typename... Args>
+    void emplace_front_aux(Args&&... args);
+    void pop_back_aux();
+    void pop_front_aux();
+    iterator insert_aux(iterator pos, T&& x);
+
+    /* map 尾端的备用节点不足 nodes_to_add 个时，重换一个 map */
+    void reserve_map_at_back(size_type nodes_to_add = 1)
+    {
+        if (nodes_to_add + 1 > map_size - (finish.node - map))
+            reallocate_map(nodes_to_add, false);
+    }
+    void reserve_map_at_front(size_type nodes_to_add = 1)
+    {
+        if (nodes_to_add > size_type(start.node - map))
+            reallocate_map(nodes_to_add, true);
+    }
+    void reallocate_map(size_type nodes_to_add, bool add_at_front);
+};
+
+template <typename T, typename Alloc>
+inline void swap(deque<T, Alloc>& x, deque<T, Alloc>& y) noexcept
+{
+    x.swap(y);
+}
+
+/* 配置 map 以及容纳 num_elements 个元素所需的缓冲区，
+ * 缓冲区集中在 map 的中段，使头尾两端都有扩充的余地 */
+template <typename T, typename Alloc>
+void deque<T, Alloc>::create_map_and_nodes(size_type num_elements)
+{
+    size_type num_nodes = num_elements / buffer_size() + 1;
+
+    map_size = mystl::max((size_type) __DEQUE_INITIAL_MAP_SIZE, num_nodes + 2);
+    map = map_allocator::allocate(this->allocator(), map_size);
+
+    map_pointer nstart = map + (map_size - num_nodes) / 2;
+    map_pointer nfinish = nstart + num_nodes - 1;
+    map_pointer cur;
+    try {
+        for (cur = nstart; cur <= nfinish; ++cur)
+            *cur = allocate_node();
+    } catch (...) {
+        /* commit or rollback */
+        for (map_pointer n = nstart; n < cur; ++n)
+            deallocate_node(*n);
+        map_allocator::deallocate(this->allocator(), map, map_size);
+        map = 0;
+        throw;
+    }
+
+    start.set_node(nstart);
+    finish.set_node(nfinish);
+    start.cur = start.first;
+    finish.cur = finish.first + num_elements % buffer_size();
+}
+
+/* 释放所有缓冲区与 map，元素已经析构 */
+template <typename T, typename Alloc>
+void deque<T, Alloc>::destroy_map_and_nodes()
+{
+    for (map_pointer cur = start.node; cur <= finish.node; ++cur)
+        deallocate_node(*cur);
+    map_allocator::deallocate(this->allocator(), map, map_size);
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::fill_initialize(size_type n, const T& value)
+{
+    create_map_and_nodes(n);
+    map_pointer cur;
+    try {
+        for (cur = start.node; cur < finish.node; ++cur)
+            mystl::uninitialized_fill(*cur, *cur + buffer_size(), value);
+        mystl::uninitialized_fill(finish.first, finish.cur, value);
+    } catch (...) {
+        mystl::destroy(start, iterator(*cur, cur));
+        destroy_map_and_nodes();
+        throw;
+    }
+}
+
+/* 最后一个缓冲区只剩一个备用空间时: 配置新的缓冲区，构造元素，finish 跳到新缓冲区 */
+template <typename T, typename Alloc>
+template <typename... Args>
+void deque<T, Alloc>::emplace_back_aux(Args&&... args)
+{
+    reserve_map_at_back();
+    *(finish.node + 1) = allocate_node();
+    try {
+        mystl::construct(finish.cur, std::forward<Args>(args)...);
+    } catch (...) {
+        deallocate_node(*(finish.node + 1));
+        throw;
+    }
+    finish.set_node(finish.node + 1);
+    finish.cur = finish.first;
+}
+
+/* 第一个缓冲区没有备用空间时: 配置新的缓冲区，start 跳到新缓冲区的最后一个位置 */
+template <typename T, typename Alloc>
+template <typename... Args>
+void deque<T, Alloc>::emplace_front_aux(Args&&... args)
+{
+    reserve_map_at_front();
+    *(start.node - 1) = allocate_node();
+    try {
+        mystl::construct(*(start.node - 1) + (buffer_size() - 1),
+                std::forward<Args>(args)...);
+    } catch (...) {
+        deallocate_node(*(start.node - 1));
+        throw;
+    }
+    start.set_node(start.node - 1);
+    start.cur = start.last - 1;
+}
+
+/* finish.cur == finish.first: 释放最后一个缓冲区，finish 跳到前一个缓冲区的最后一个元素 */
+template <typename T, typename Alloc>
+void deque<T, Alloc>::pop_back_aux()
+{
+    deallocate_node(finish.first);
+    finish.set_node(finish.node - 1);
+    finish.cur = finish.last - 1;
+    mystl::destroy(finish.cur);
+}
+
+/* start.cur == start.last - 1: 析构最后一个元素后释放第一个缓冲区 */
+template <typename T, typename Alloc>
+void deque<T, Alloc>::pop_front_aux()
+{
+    mystl::destroy(start.cur);
+    deallocate_node(start.first);
+    start.set_node(start.node + 1);
+    start.cur = start.first;
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::clear()
+{
+    /* 头尾以外的缓冲区都是满的 */
+    for (map_pointer node = start.node + 1; node < finish.node; ++node) {
+        mystl::destroy(*node, *node + buffer_size());
+        deallocate_node(*node);
+    }
+    if (start.node != finish.node) {
+        mystl::destroy(start.cur, start.last);
+        mystl::destroy(finish.first, finish.cur);
+        deallocate_node(finish.first);      /* 保留头缓冲区 */
+    }
+    else
+        mystl::destroy(start.cur, finish.cur);
+    finish = start;
+}
+
+/* 清除 [first, last)，移动两侧中较少的一侧 */
+template <typename T, typename Alloc>
+typename deque<T, Alloc>::iterator
+deque<T, Alloc>::erase(iterator first, iterator last)
+{
+    if (first == last)
+        return first;
+    if (first == start && last == finish) {
+        clear();
+        return finish;
+    }
+    difference_type n = last - first;
+    difference_type elems_before = first - start;
+    if (elems_before < difference_type((size() - n) / 2)) {
+        mystl::move_backward(start, first, last);
+        iterator new_start = start + n;
+        mystl::destroy(start, new_start);
+        for (map_pointer cur = start.node; cur < new_start.node; ++cur)
+            deallocate_node(*cur);
+        start = new_start;
+    }
+    else {
+        mystl::move(last, finish, first);
+        iterator new_finish = finish - n;
+        mystl::destroy(new_finish, finish);
+        for (map_pointer cur = new_finish.node + 1; cur <= finish.node; ++cur)
+            deallocate_node(*cur);
+        finish = new_finish;
+    }
+    return start + elems_before;
+}
+
+/* 在 pos 处插入 x，移动两侧中较少的一侧 */
+template <typename T, typename Alloc>
+typename deque<T, Alloc>::iterator
+deque<T, Alloc>::insert_aux(iterator pos, T&& x)
+{
+    difference_type index = pos - start;
+    if (size_type(index) < size() / 2) {
+        emplace_front(std::move(front()));
+        iterator front1 = start;
+        ++front1;
+        iterator front2 = front1;
+        ++front2;
+        pos = start + index;
+        iterator pos1 = pos;
+        ++pos1;
+        mystl::move(front2, pos1, front1);
+    }
+    else {
+        emplace_back(std::move(back()));
+        iterator back1 = finish;
+        --back1;
+        iterator back2 = back1;
+        --back2;
+        pos = start + index;
+        mystl::move_backward(pos, back2, back1);
+    }
+    *pos = std::move(x);
+    return pos;
+}
+
+/* map 两端的备用节点不足: map 足够大时把节点移到中段，否则配置更大的 map。
+ * 只搬移缓冲区的指针，元素不动 */
+template <typename T, typename Alloc>
+void deque<T, Alloc>::reallocate_map(size_type nodes_to_add, bool add_at_front)
+{
+    size_type old_num_nodes = finish.node - start.node + 1;
+    size_type new_num_nodes = old_num_nodes + nodes_to_add;
+
+    map_pointer new_nstart;
+    if (map_size > 2 * new_num_nodes) {
+        new_nstart = map + (map_size - new_num_nodes) / 2
+            + (add_at_front ? nodes_to_add : 0);
+        if (new_nstart < start.node)
+            mystl::copy(start.node, finish.node + 1, new_nstart);
+        else
+            mystl::copy_backward(start.node, finish.node + 1, new_nstart + old_num_nodes);
+    }
+    else {
+        size_type new_map_size = map_size + mystl::max(map_size, nodes_to_add) + 2;
+        map_pointer new_map = map_allocator::allocate(this->allocator(), new_map_size);
+        new_nstart = new_map + (new_map_size - new_num_nodes) / 2
+            + (add_at_front ? nodes_to_add : 0);
+        mystl::copy(start.node, finish.node + 1, new_nstart);
+        map_allocator::deallocate(this->allocator(), map, map_size);
+        map = new_map;
+        map_size = new_map_size;
+    }
+
+    start.set_node(new_nstart);
+    finish.set_node(new_nstart + old_num_nodes - 1);
+}
+
+}
+
+#endif
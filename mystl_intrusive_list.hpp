@@ -0,0 +1,278 @@
+/* file		: mystl_intrusive_list.hpp
+ * by		: waterlemon	429426523@qq.com
+ * date		: Sun 18 Oct 2026 05:47:40 PM CST
+ * last update	:
+ *
+ * description	: intrusive_list_hook, intrusive_list
+ * list 的结点包含一份元素的复制，每次插入都要配置空间并复制元素。
+ * intrusive_list 不持有元素: 指针 (hook) 就在使用者的对象里，链表只是把已有的对象串起来，
+ * 插入与删除都不配置空间，也不构造或析构对象。对象的生存期由使用者负责:
+ *      struct task : intrusive_list_hook<> { ... };
+ *      intrusive_list<task> ready;
+ *      ready.push_back(t);         // t 是 task&，不复制
+ *      ready.erase(t);             // O(1)，只需要对象本身
+ *
+ * 同一个对象要同时在多个 intrusive_list 中时，以不同的 Tag 继承多个 hook:
+ *      struct task : intrusive_list_hook<ready_tag>, intrusive_list_hook<timer_tag> { ... };
+ *      intrusive_list<task, timer_tag> timers;
+ *
+ * hook 可以不经过链表直接 unlink()，所以链表不记录元素个数，size() 是 O(n)。
+ */
+
+#ifndef     _MYSTL_INTRUSIVE_LIST_
+#define     _MYSTL_INTRUSIVE_LIST_
+
+#include "mystl_iterator.hpp"   /* bidirectional_iterator_tag{} */
+
+#include <cstddef>              /* size_t, ptrdiff_t */
+#include <utility>              /* std::swap() */
+
+namespace mystl
+{
+
+/* 对象以 public 继承的方式含有 hook。
+ * 不在任何链表中时 prev 与 next 都是 0；对象析构时自动从链表中取下 */
+template <typename Tag = void>
+struct intrusive_list_hook {
+    intrusive_list_hook* prev;
+    intrusive_list_hook* next;
+
+    intrusive_list_hook() : prev(0), next(0) {}
+    /* 复制对象并不会把复制品放进同一个链表 */
+    intrusive_list_hook(const intrusive_list_hook&) : prev(0), next(0) {}
+    intrusive_list_hook& operator= (const intrusive_list_hook&) { return *this; }
+    ~intrusive_list_hook() { unlink(); }
+
+    bool is_linked() const { return next != 0; }
+
+    /* 从所在的链表中取下，不需要知道是哪一个链表 */
+    void unlink()
+    {
+        if (next) {
+            prev->next = next;
+            next->prev = prev;
+            prev = next = 0;
+        }
+    }
+};
+
+/* intrusive_list迭代器: __intrusive_list_iterator */
+template <typename T, typename Tag, typename Ref, typename Ptr>
+struct __intrusive_list_iterator {
+    typedef __intrusive_list_iterator<T, Tag, T&, T*>   iterator;
+    typedef __intrusive_list_iterator<T, Tag, Ref, Ptr> self;
+
+    typedef bidirectional_iterator_tag      iterator_category;
+    typedef T                               value_type;
+    typedef Ptr                             pointer;
+    typedef Ref                             reference;
+    typedef ptrdiff_t                       difference_type;
+    typedef size_t                          size_type;
+
+    typedef intrusive_list_hook<Tag>*       hook_pointer;
+
+    hook_pointer node;
+
+    __intrusive_list_iterator(hook_pointer x) : node(x) {}
+    __intrusive_list_iterator() : node(0) {}
+    __intrusive_list_iterator(const iterator& x) : node(x.node) {}
+
+    bool operator== (const self& x) const { return node == x.node; }
+    bool operator!= (const self& x) const { return node != x.node; }
+
+    reference operator* () const { return *static_cast<T*>(node); }
+    pointer operator-> () const { return &(operator*()); }
+
+    self& operator++ ()
+    {
+        node = node->next;
+        return *this;
+    }
+    self operator++ (int)
+    {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+    self& operator-- ()
+    {
+        node = node->prev;
+        return *this;
+    }
+    self operator-- (int)
+    {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+};
+
+/* 与 list 一样是环形链表，头结点是链表对象内部的一个 hook */
+template <typename T, typename Tag = void>
+class intrusive_list {
+public:
+    typedef T                               value_type;
+    typedef T*                              pointer;
+    typedef T&                              reference;
+    typedef ptrdiff_t                       difference_type;
+    typedef size_t                          size_type;
+    typedef __intrusive_list_iterator<T, Tag, T&, T*> iterator;
+    typedef intrusive_list_hook<Tag>        hook_type;
+
+protected:
+    typedef hook_type*                      hook_pointer;
+
+    hook_type head;
+
+    /* 禁止复制: 一个对象只能在一个链表中 */
+    intrusive_list(const intrusive_list&);
+    intrusive_list& operator= (const intrusive_list&);
+
+    static hook_pointer hook(reference x) { return static_cast<hook_pointer>(&x); }
+
+    void empty_initialize() { head.prev = head.next = &head; }
+    /* 交换 head 之后，让首尾结点指回本对象的 head */
+    void relink_head(hook_pointer old_head)
+    {
+        if (head.next == old_head)
+            empty_initialize();
+        else {
+            head.next->prev = &head;
+            head.prev->next = &head;
+        }
+    }
+
+    /* 把 [first, last) 移到 position 之前，与 list::transfer() 相同 */
+    void transfer(iterator position, iterator first, iterator last)
+    {
+        if (position != last) {
+            hook_pointer tmp = position.node->prev;
+            last.node->prev->next = position.node;
+            first.node->prev->next = last.node;
+            tmp->next = first.node;
+            position.node->prev = last.node->prev;
+            last.node->prev = first.node->prev;
+            first.node->prev = tmp;
+        }
+    }
+
+public:
+    iterator begin() { return head.next; }
+    iterator end() { return &head; }
+    bool empty() { return head.next == &head; }
+    /* 需要走过整个链表 */
+    size_type size() { return mystl::distance(begin(), end()); }
+    reference front() { return *begin(); }
+    reference back() { return *(--end()); }
+
+    /* 由对象得到指向它的迭代器，x 必须在本链表中 */
+    static iterator iterator_to(reference x) { return hook(x); }
+
+public:
+    intrusive_list() { empty_initialize(); }
+    /* 移动构造: 接管 x 的所有对象 */
+    intrusive_list(intrusive_list&& x)
+    {
+        empty_initialize();
+        swap(x);
+    }
+    intrusive_list& operator= (intrusive_list&& x)
+    {
+        if (this != &x) {
+            clear();
+            swap(x);
+        }
+        return *this;
+    }
+    /* 取下所有对象，对象本身不受影响 */
+    ~intrusive_list()
+    {
+        clear();
+        head.prev = head.next = 0;
+    }
+
+    void swap(intrusive_list& x) noexcept
+    {
+        std::swap(head.prev, x.head.prev);
+        std::swap(head.next, x.head.next);
+        relink_head(&x.head);
+        x.relink_head(&head);
+    }
+
+public:
+    /* x 不可以已经在某个链表中 */
+    iterator insert(iterator position, reference x)
+    {
+        hook_pointer tmp = hook(x);
+        tmp->next = position.node;
+        tmp->prev = position.node->prev;
+        position.node->prev->next = tmp;
+        position.node->prev = tmp;
+        return tmp;
+    }
+    void push_back(reference x) { insert(end(), x); }
+    void push_front(reference x) { insert(begin(), x); }
+
+    iterator erase(iterator position)
+    {
+        if (position == end())
+            return position;
+        hook_pointer next_node = position.node->next;
+        position.node->unlink();
+        return next_node;
+    }
+    iterator erase(iterator first, iterator last)
+    {
+        while (first != last)
+            first = erase(first);
+        return last;
+    }
+    /* 由对象本身取下，O(1) */
+    void erase(reference x) { hook(x)->unlink(); }
+
+    void pop_front() { erase(begin()); }
+    void pop_back() { erase(--end()); }
+
+    void clear()
+    {
+        hook_pointer cur = head.next;
+        while (cur != &head) {
+            hook_pointer next = cur->next;
+            cur->prev = cur->next = 0;
+            cur = next;
+        }
+        empty_initialize();
+    }
+
+    /* 把 x 的全部对象移到 position 之前 */
+    void splice(iterator position, intrusive_list& x)
+    {
+        if (!x.empty())
+            transfer(position, x.begin(), x.end());
+    }
+    /* 把 i 所指的对象移到 position 之前，i 可以属于本链表 */
+    void splice(iterator position, intrusive_list& /* x */, iterator i)
+    {
+        iterator j = i;
+        ++j;
+        if (position == i || position == j)
+            return;
+        transfer(position, i, j);
+    }
+    /* 把 [first, last) 移到 position 之前，position 不可以在 [first, last) 之内 */
+    void splice(iterator position, intrusive_list& /* x */, iterator first, iterator last)
+    {
+        if (first != last)
+            transfer(position, first, last);
+    }
+};
+
+template <typename T, typename Tag>
+inline void swap(intrusive_list<T, Tag>& x, intrusive_list<T, Tag>& y) noexcept
+{
+    x.swap(y);
+}
+
+}
+
+#endif
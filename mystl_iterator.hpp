@@ -10,6 +10,7 @@
  *      iterator{}          供自行设计迭代器时继承
  *      iterator_traits{}
  *      iterator_category(), difference_type(), value_type()
+ *      distance(), advance()
  */
 
 #ifndef     _MYSTL_ITERATOR_
@@ -123,6 +124,35 @@ __distance(RandomAccessIterator first, RandomAccessIterator last,
     return last - first;
 }
 
+/* advance() */
+template <typename InputIterator, typename Distance>
+inline void advance(InputIterator& i, Distance n)
+{
+    typedef typename iterator_traits<InputIterator>::iterator_category category;
+    __advance(i, n, category());
+}
+
+template <typename InputIterator, typename Distance>
+inline void __advance(InputIterator& i, Distance n, input_iterator_tag)
+{
+    while (n--) ++i;
+}
+
+template <typename BidirectionalIterator, typename Distance>
+inline void __advance(BidirectionalIterator& i, Distance n, bidirectional_iterator_tag)
+{
+    if (n >= 0)
+        while (n--) ++i;
+    else
+        while (n++) --i;
+}
+
+template <typename RandomAccessIterator, typename Distance>
+inline void __advance(RandomAccessIterator& i, Distance n, random_access_iterator_tag)
+{
+    i += n;
+}
+
 }
 
 
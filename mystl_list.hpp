@@ -10,11 +10,12 @@
 #ifndef	    _MYSTL_LIST_
 #define	    _MYSTL_LIST_
 
-#include "mystl_alloc.hpp"          /* alloc{}, simple_alloc{} */
+#include "mystl_alloc.hpp"          /* alloc{}, simple_alloc{}, __alloc_holder{}, __alloc_reserve{}, __alloc_equal{} */
 #include "mystl_iterator.hpp"       /* iterator_traits, distance() */
 #include "mystl_construct.hpp"      /* construct() */
 
 #include <cstddef>      /* ptrdiff_t */
+#include <utility>      /* std::swap(), std::move(), std::forward() */
 
 namespace mystl
 {
@@ -81,10 +82,21 @@ struct __list_iterator {
     }
 };
 
+/* list::sort(), merge(), unique() 缺省的比较方式 */
+struct __list_less {
+    template <typename T>
+    bool operator() (const T& a, const T& b) const { return a < b; }
+};
+struct __list_equal_to {
+    template <typename T>
+    bool operator() (const T& a, const T& b) const { return a == b; }
+};
+
 /* list 是一个双向链表，也是一个环形链表 */
 template <typename T, typename Alloc = alloc>
-class list {
+class list : protected __alloc_holder<Alloc> {
 protected:
+    typedef __alloc_holder<Alloc>           alloc_base;
     typedef __list_node<T>  list_node;
     typedef list_node*      link_type;
     typedef simple_alloc<list_node, Alloc>  list_node_allocator;
@@ -101,70 +113,111 @@ public:
     typedef const T&        const_reference;
     typedef typename iterator_traits<iterator>::difference_type  difference_type;
     typedef typename iterator::size_type    size_type;
+    typedef Alloc                           allocator_type;
+
+    using alloc_base::get_allocator;
 
 protected:
     /* 空间置配 */
-    link_type get_node() { return list_node_allocator::allocate(); }
-    void put_node(link_type p) { return list_node_allocator::deallocate(p); }
+    link_type get_node() { return list_node_allocator::allocate(this->allocator()); }
+    void put_node(link_type p) { list_node_allocator::deallocate(this->allocator(), p); }
 
-    /* 构造 */
-    link_type create_node(const_reference x)
+    /* 以 args 为参数在结点内直接构造元素，构造失败时归还结点 */
+    template <typename... Args>
+    link_type create_node(Args&&... args)
     {
         link_type p = get_node();
-        construct(&p->data, x);            /* mystl_construct.hpp */
+        try {
+            mystl::construct(&p->data, std::forward<Args>(args)...);   /* mystl_construct.hpp */
+        } catch (...) {
+            put_node(p);
+            throw;
+        }
         return p;
     }
     void destroy_node(link_type p)
     {
-        destroy(&p->data);
+        mystl::destroy(&p->data);
         put_node(p);
     }
 
 protected:
     link_type head;
+    size_type length;   /* 元素个数: 每个改变元素个数的操作都要同时维护它，size() 因此是 O(1) */
 
 public:
     iterator begin() const { return (link_type) (head->next);  }
     iterator end() const { return head; }
     bool empty() const { return head->next == head; }
-    size_type size() const 
-    {
-        size_type result = 0;
-        result = distance(begin(), end());
-        return result;
-    }
+    size_type size() const { return length; }
     reference front() const { return *(begin()); }
     reference back() const { return *(--end()); }
 
 public:
     list() { empty_initialize(); }      /* 产生一个空链表 */
+    explicit list(const Alloc& a) : alloc_base(a) { empty_initialize(); }
     /* fill */
-    explicit list(size_type n)
+    explicit list(size_type n, const Alloc& a = Alloc()) : alloc_base(a)
     {
         empty_initialize();
+        __alloc_reserve<Alloc>::reserve(this->allocator(), n, sizeof (list_node));
         while (n--)
             push_back(value_type());
     }
-    list(size_type n, const_reference val)
+    list(size_type n, const_reference val, const Alloc& a = Alloc()) : alloc_base(a)
     {
         empty_initialize();
+        /* 能够批量配置的配置器一次准备好 n 个结点 */
+        __alloc_reserve<Alloc>::reserve(this->allocator(), n, sizeof (list_node));
         while (n--)
             push_back(val);
     }
     /* copy */
-    list(const list& x)
+    list(const list& x) : alloc_base(x.get_allocator())
     {
         empty_initialize();
-        //!
-        typename list<value_type>::iterator xit = x.begin();
-        for (; xit != x.end(); ++xit) {
-            insert(end(), *(xit));
+        try {
+            iterator xit = x.begin();
+            for (; xit != x.end(); ++xit) {
+                insert(end(), *(xit));
+            }
+        } catch (...) {
+            clear();
+            put_node(head);
+            throw;
+        }
+    }
+    /* 复制赋值: 先赋值给已有的结点，多余的结点删除，不足时再配置；配置器不随之复制 */
+    list& operator= (const list& x)
+    {
+        if (this != &x) {
+            iterator first1 = begin(), last1 = end();
+            iterator first2 = x.begin(), last2 = x.end();
+            for (; first1 != last1 && first2 != last2; ++first1, ++first2)
+                *first1 = *first2;
+            if (first2 == last2) {
+                while (first1 != last1)
+                    first1 = erase(first1);
+            }
+            else {
+                for (; first2 != last2; ++first2)
+                    insert(last1, *first2);
+            }
         }
+        return *this;
     }
     ~list()
     {
         clear();
-        destroy_node(head);
+        put_node(head);     /* head 的 data 没有构造过 */
+    }
+
+    /* 交换两个 list 的头结点与配置器，不复制任何元素 */
+    void swap(list& x) noexcept
+    {
+        std::swap(this->allocator(), x.allocator());
+        std::swap(head, x.head);
+        std::swap(length, x.length);
     }
 
 protected:
@@ -173,19 +226,32 @@ protected:
         head = get_node();
         head->next = head;
         head->prev = head;
+        length = 0;
     }
 
 public:
     void push_back(const_reference x) { insert(end(), x); }
+    void push_back(value_type&& x) { insert(end(), std::move(x)); }
     void push_front(const_reference x) { insert(begin(), x); }
-
-    iterator insert(iterator position, const_reference x) /* 在position之前插入 */
+    void push_front(value_type&& x) { insert(begin(), std::move(x)); }
+    template <typename... Args>
+    void emplace_back(Args&&... args) { emplace(end(), std::forward<Args>(args)...); }
+    template <typename... Args>
+    void emplace_front(Args&&... args) { emplace(begin(), std::forward<Args>(args)...); }
+
+    iterator insert(iterator position, const_reference x) { return emplace(position, x); }
+    iterator insert(iterator position, value_type&& x) { return emplace(position, std::move(x)); }
+
+    /* 在position之前以 args 直接构造一个元素，不产生临时对象 */
+    template <typename... Args>
+    iterator emplace(iterator position, Args&&... args)
     {
-        link_type tmp = create_node(x);
+        link_type tmp = create_node(std::forward<Args>(args)...);
         tmp->next = position.node;
         tmp->prev = position.node->prev;
         (link_type (position.node->prev))->next = tmp;
         position.node->prev = tmp;
+        ++length;
         return tmp;
     }
 
@@ -199,6 +265,7 @@ public:
         next_node->prev = prev_node;
 
         destroy_node(position.node);
+        --length;
         return iterator (next_node);
     }
 
@@ -215,10 +282,228 @@ public:
         }
         head->next = head;
         head->prev = head;
+        length = 0;
+    }
+
+protected:
+    /* 把 [first, last) 内的所有元素移到 position 之前，只修改指针，不配置也不复制。
+     * position 不可以在 [first, last) 之内；[first, last) 可以属于另一个 list。
+     * 不修改 length，由调用者调整两个 list 的元素个数 */
+    void transfer(iterator position, iterator first, iterator last)
+    {
+        if (position != last) {
+            link_type tmp = link_type (position.node->prev);
+            (link_type (last.node->prev))->next = position.node;
+            (link_type (first.node->prev))->next = last.node;
+            tmp->next = first.node;
+            position.node->prev = last.node->prev;
+            last.node->prev = first.node->prev;
+            first.node->prev = tmp;
+        }
+    }
+
+    /* 合并两条以 0 结尾、已排序的单向链 (只看 next)。相等时 a 的元素在前，所以是稳定的 */
+    template <typename Compare>
+    static link_type merge_chains(link_type a, link_type b, Compare comp)
+    {
+        void* result;
+        void** tail = &result;
+        while (a && b) {
+            if (comp(b->data, a->data)) {
+                *tail = b;
+                tail = &b->next;
+                b = link_type (b->next);
+            }
+            else {
+                *tail = a;
+                tail = &a->next;
+                a = link_type (a->next);
+            }
+        }
+        *tail = a ? a : b;
+        return link_type (result);
+    }
+
+    /* x 的结点能否直接接到本 list: 两者的配置器相等时，结点可以由本 list 释放 */
+    bool same_allocator(list& x) { return __alloc_equal<Alloc>::equal(this->allocator(), x.allocator()); }
+
+    /* 配置器不相等时的 splice: 把 [first, last) 的元素逐个移动到 position 之前，再从 x 删除 */
+    void move_elements(iterator position, list& x, iterator first, iterator last)
+    {
+        while (first != last) {
+            emplace(position, std::move(*first));
+            first = x.erase(first);
+        }
+    }
+
+public:
+    /* 以下操作都只修改结点的指针，不配置空间，也不复制元素。
+     * 元素来自另一个 list x 且两者的配置器不相等时 (如各自持有 slab 的 slab_alloc)，
+     * 结点不能交给本 list 释放，改为逐个移动元素再从 x 删除，是 O(n) 并且会配置空间 */
+
+    /* 把 x 的全部元素移到 position 之前 */
+    void splice(iterator position, list& x)
+    {
+        if (!same_allocator(x)) {
+            move_elements(position, x, x.begin(), x.end());
+            return;
+        }
+        if (!x.empty()) {
+            transfer(position, x.begin(), x.end());
+            length += x.length;
+            x.length = 0;
+        }
+    }
+    /* 把 i 所指的元素移到 position 之前，i 可以属于本 list */
+    void splice(iterator position, list& x, iterator i)
+    {
+        iterator j = i;
+        ++j;
+        if (position == i || position == j)
+            return;
+        if (!same_allocator(x)) {
+            move_elements(position, x, i, j);
+            return;
+        }
+        transfer(position, i, j);
+        ++length;
+        --x.length;
+    }
+    /* 把 [first, last) 移到 position 之前，position 不可以在 [first, last) 之内。
+     * x 是另一个 list 时需要数出移动的元素个数，是 O(n)；在本 list 之内移动是 O(1) */
+    void splice(iterator position, list& x, iterator first, iterator last)
+    {
+        if (first == last)
+            return;
+        if (!same_allocator(x)) {
+            move_elements(position, x, first, last);
+            return;
+        }
+        if (&x != this) {
+            size_type n = mystl::distance(first, last);
+            length += n;
+            x.length -= n;
+        }
+        transfer(position, first, last);
+    }
+
+    /* 两个 list 都已递增排序，把 x 合并进来，x 成为空 list */
+    void merge(list& x) { merge(x, __list_less()); }
+    template <typename Compare>
+    void merge(list& x, Compare comp)
+    {
+        if (&x == this)
+            return;
+        iterator first1 = begin(), last1 = end();
+        iterator first2 = x.begin(), last2 = x.end();
+        if (!same_allocator(x)) {
+            while (first1 != last1 && first2 != last2) {
+                if (comp(*first2, *first1)) {
+                    emplace(first1, std::move(*first2));
+                    first2 = x.erase(first2);
+                }
+                else
+                    ++first1;
+            }
+            move_elements(last1, x, first2, last2);
+            return;
+        }
+        while (first1 != last1 && first2 != last2) {
+            if (comp(*first2, *first1)) {
+                iterator next = first2;
+                transfer(first1, first2, ++next);
+                first2 = next;
+            }
+            else
+                ++first1;
+        }
+        if (first2 != last2)
+            transfer(last1, first2, last2);
+        length += x.length;
+        x.length = 0;
     }
 
+    /* 逆置: 交换每个结点 (包括 head) 的 prev 与 next */
+    void reverse()
+    {
+        link_type cur = head;
+        do {
+            void* tmp = cur->next;
+            cur->next = cur->prev;
+            cur->prev = tmp;
+            cur = link_type (tmp);
+        } while (cur != head);
+    }
+
+    /* 删除连续而相同的元素，只留第一个 */
+    void unique() { unique(__list_equal_to()); }
+    template <typename BinaryPredicate>
+    void unique(BinaryPredicate pred)
+    {
+        iterator first = begin(), last = end();
+        if (first == last)
+            return;
+        iterator next = first;
+        while (++next != last) {
+            if (pred(*first, *next))
+                erase(next);
+            else
+                first = next;
+            next = first;
+        }
+    }
+
+    /* 稳定的 bottom-up merge sort，O(n log n)。
+     * 先把链拆成以 0 结尾的单向链，bins[i] 存放长度为 2^i 的已排序链，
+     * 每取下一个结点就像二进制加 1 一样逐级合并，最后重建 prev 指针。
+     * 只使用固定大小的 bins，不配置空间 */
+    void sort() { sort(__list_less()); }
+    template <typename Compare>
+    void sort(Compare comp)
+    {
+        if (head->next == head || (link_type (head->next))->next == head)
+            return;
+
+        link_type bins[sizeof (size_t) * 8];
+        int fill = 0;
+        link_type node = link_type (head->next);
+        (link_type (head->prev))->next = 0;
+        while (node) {
+            link_type carry = node;
+            node = link_type (node->next);
+            carry->next = 0;
+            int i = 0;
+            for (; i < fill && bins[i]; i++) {
+                carry = merge_chains(bins[i], carry, comp);     /* bins[i] 的元素在前 */
+                bins[i] = 0;
+            }
+            bins[i] = carry;
+            if (i == fill)
+                ++fill;
+        }
+        link_type result = 0;
+        for (int i = 0; i < fill; i++) {
+            if (bins[i])
+                result = result ? merge_chains(bins[i], result, comp) : bins[i];
+        }
+
+        link_type prev = head;
+        for (link_type p = result; p; p = link_type (p->next)) {
+            p->prev = prev;
+            prev->next = p;
+            prev = p;
+        }
+        prev->next = head;
+        head->prev = prev;
+    }
 };
 
+template <typename T, typename Alloc>
+inline void swap(list<T, Alloc>& x, list<T, Alloc>& y) noexcept
+{
+    x.swap(y);
+}
+
 }
 
 #endif
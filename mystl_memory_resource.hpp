@@ -0,0 +1,278 @@
+/* file		: mystl_memory_resource.hpp
+ * by		: waterlemon	429426523@qq.com
+ * date		: Sat 17 Oct 2026 01:25:48 PM CST
+ * last update	:
+ *
+ * description	: memory_resource, malloc_resource, pool_resource, arena_resource,
+ *      polymorphic_alloc
+ * memory_resource 是一个抽象的内存来源，以虚函数提供 allocate/deallocate。
+ * polymorphic_alloc 只保存一个 memory_resource 指针，作为容器的 Alloc 参数，
+ * 于是同一个容器型别 vector<T, polymorphic_alloc> 可以在运行时使用不同的内存来源:
+ *      pool_resource pool;
+ *      vector<int, polymorphic_alloc> v((polymorphic_alloc(&pool)));
+ */
+
+#ifndef     _MYSTL_MEMORY_RESOURCE_
+#define     _MYSTL_MEMORY_RESOURCE_
+
+#include "mystl_alloc.hpp"      /* malloc_alloc{}, __alloc_equal{}, __MAX_BYTES, __MAX_ALIGN */
+#include "mystl_arena.hpp"      /* arena{} */
+
+#include <cstring>              /* memcpy() */
+#include <cstddef>              /* size_t */
+
+namespace mystl
+{
+
+enum { __POOL_NFREELISTS = __MAX_BYTES / __MAX_ALIGN };
+
+/* memory_resource 抽象基类
+ * align 必须是 2 的幂次 */
+class memory_resource {
+public:
+    virtual ~memory_resource() {}
+
+    void* allocate(size_t bytes, size_t align = __MAX_ALIGN)
+        { return do_allocate(bytes, align); }
+    void deallocate(void* p, size_t bytes, size_t align = __MAX_ALIGN)
+        { do_deallocate(p, bytes, align); }
+    bool is_equal(const memory_resource& x) const
+        { return do_is_equal(x); }
+
+private:
+    virtual void* do_allocate(size_t bytes, size_t align) = 0;
+    virtual void  do_deallocate(void* p, size_t bytes, size_t align) = 0;
+    virtual bool  do_is_equal(const memory_resource& x) const
+        { return this == &x; }
+};
+
+inline bool operator== (const memory_resource& a, const memory_resource& b)
+    { return &a == &b || a.is_equal(b); }
+inline bool operator!= (const memory_resource& a, const memory_resource& b)
+    { return !(a == b); }
+
+
+/* (1) malloc_resource: 直接使用第一级配置器 malloc_alloc */
+class malloc_resource : public memory_resource {
+private:
+    virtual void* do_allocate(size_t bytes, size_t align)
+        { return malloc_alloc::allocate(bytes, align); }
+    virtual void do_deallocate(void* p, size_t bytes, size_t align)
+        { malloc_alloc::deallocate(p, bytes, align); }
+    virtual bool do_is_equal(const memory_resource& x) const
+        { return dynamic_cast<const malloc_resource*>(&x) != 0; }
+};
+
+/* 缺省的 memory_resource */
+inline memory_resource* get_default_resource()
+{
+    static malloc_resource r;
+    return &r;
+}
+
+
+/* (2) pool_resource: 与 default_alloc 相同的 free-list 设计，但内存池属于对象本身。
+ * 区块以 __MAX_ALIGN 为上调边界，因此任何对齐要求不超过 __MAX_ALIGN 的区块都可以由 free-list 供应；
+ * 大区块以及对齐要求超过 __MAX_ALIGN 的区块交给 upstream；
+ * 从 upstream 取得的 chunk 在 release() 或析构时全部归还 */
+class pool_resource : public memory_resource {
+private:
+    union obj {
+        union obj* free_list_link;
+        char client_data[1];
+    };
+    /* chunk 的头部，串接所有从 upstream 取得的 chunk */
+    struct chunk {
+        chunk*  next;
+        size_t  size;
+    };
+
+    static size_t ROUND_UP(size_t bytes)
+        { return (bytes + __MAX_ALIGN - 1) & ~((size_t) __MAX_ALIGN - 1); }
+    static size_t FREELIST_INDEX(size_t bytes)
+        { return (bytes + __MAX_ALIGN - 1) / __MAX_ALIGN - 1; }
+
+    memory_resource*    upstream;
+    obj*                free_list[__POOL_NFREELISTS];
+    chunk*              chunks;
+    char*               start_free;
+    char*               end_free;
+    size_t              heap_size;
+
+    /* 禁止复制 */
+    pool_resource(const pool_resource&);
+    pool_resource& operator= (const pool_resource&);
+
+    void* refill(size_t n)
+    {
+        int nobjs = 20;
+        char* p = chunk_alloc(n, nobjs);
+        if (nobjs == 1)
+            return p;
+
+        obj** my_free_list = free_list + FREELIST_INDEX(n);
+        obj* result = (obj*) p;
+        obj* next_obj = (obj*) (p + n);
+        *my_free_list = next_obj;
+        for (int i = 1; ; i++) {
+            obj* current_obj = next_obj;
+            next_obj = (obj*) ((char*) next_obj + n);
+            if (nobjs - 1 == i) {
+                current_obj->free_list_link = 0;
+                break;
+            }
+            current_obj->free_list_link = next_obj;
+        }
+        return result;
+    }
+
+    char* chunk_alloc(size_t size, int& nobjs)
+    {
+        size_t total_bytes = size * nobjs;
+        size_t bytes_left = end_free - start_free;
+
+        if (bytes_left >= size) {
+            if (bytes_left < total_bytes)
+                nobjs = (int) (bytes_left / size);
+            char* result = start_free;
+            start_free += size * nobjs;
+            return result;
+        }
+
+        if (bytes_left > 0) {
+            obj** my_free_list = free_list + FREELIST_INDEX(bytes_left);
+            ((obj*) start_free)->free_list_link = *my_free_list;
+            *my_free_list = (obj*) start_free;
+        }
+
+        size_t bytes_to_get = 2 * total_bytes + ROUND_UP(heap_size >> 4);
+        size_t chunk_size = ROUND_UP(sizeof (chunk)) + bytes_to_get;
+        chunk* c = (chunk*) upstream->allocate(chunk_size);
+        c->next = chunks;
+        c->size = chunk_size;
+        chunks = c;
+        heap_size += bytes_to_get;
+        start_free = (char*) c + ROUND_UP(sizeof (chunk));
+        end_free = start_free + bytes_to_get;
+        return chunk_alloc(size, nobjs);
+    }
+
+    virtual void* do_allocate(size_t bytes, size_t align)
+    {
+        if (bytes > (size_t) __MAX_BYTES || align > (size_t) __MAX_ALIGN)
+            return upstream->allocate(bytes, align);
+        /* allocate(0) 是合法的请求，FREELIST_INDEX(0) 却会下溢，按最小的区块处理 */
+        if (bytes == 0)
+            bytes = 1;
+
+        obj** my_free_list = free_list + FREELIST_INDEX(bytes);
+        obj* result = *my_free_list;
+        if (result == 0)
+            return refill(ROUND_UP(bytes));
+        *my_free_list = result->free_list_link;
+        return result;
+    }
+    virtual void do_deallocate(void* p, size_t bytes, size_t align)
+    {
+        if (bytes > (size_t) __MAX_BYTES || align > (size_t) __MAX_ALIGN) {
+            upstream->deallocate(p, bytes, align);
+            return;
+        }
+        if (bytes == 0)
+            bytes = 1;
+        obj* q = (obj*) p;
+        obj** my_free_list = free_list + FREELIST_INDEX(bytes);
+        q->free_list_link = *my_free_list;
+        *my_free_list = q;
+    }
+
+public:
+    explicit pool_resource(memory_resource* up = get_default_resource())
+        : upstream(up), chunks(0), start_free(0), end_free(0), heap_size(0)
+    {
+        for (int i = 0; i < __POOL_NFREELISTS; i++)
+            free_list[i] = 0;
+    }
+    ~pool_resource() { release(); }
+
+    /* 归还全部 chunk。直接交给 upstream 的大区块不受影响 */
+    void release()
+    {
+        while (chunks) {
+            chunk* next = chunks->next;
+            upstream->deallocate(chunks, chunks->size);
+            chunks = next;
+        }
+        for (int i = 0; i < __POOL_NFREELISTS; i++)
+            free_list[i] = 0;
+        start_free = end_free = 0;
+        heap_size = 0;
+    }
+
+    memory_resource* upstream_resource() const { return upstream; }
+};
+
+
+/* (3) arena_resource: 以 arena 为内存来源，deallocate 什么也不做 */
+class arena_resource : public memory_resource {
+private:
+    arena a;
+
+    virtual void* do_allocate(size_t bytes, size_t align)
+        { return a.allocate(bytes, align); }
+    virtual void do_deallocate(void* /* p */, size_t /* bytes */, size_t /* align */) {}
+
+public:
+    explicit arena_resource(size_t block_size = 64 * 1024) : a(block_size) {}
+
+    void release() { a.release(); }
+    arena& get_arena() { return a; }
+};
+
+
+/* polymorphic_alloc: 保存一个 memory_resource 指针的配置器，
+ * 容器通过 __alloc_holder 持有它 */
+class polymorphic_alloc {
+private:
+    memory_resource* r;
+
+    /* 大小为 n 的对象，其对齐要求一定整除 n:
+     * 取整除 n 的最大的 2 的幂次，以 __MAX_ALIGN 为上限 */
+    static size_t natural_align(size_t n)
+    {
+        size_t a = n & (~n + 1);
+        return (a == 0 || a > (size_t) __MAX_ALIGN) ? (size_t) __MAX_ALIGN : a;
+    }
+
+public:
+    polymorphic_alloc() : r(get_default_resource()) {}
+    polymorphic_alloc(memory_resource* x) : r(x) {}
+
+    void* allocate(size_t n) { return r->allocate(n, natural_align(n)); }
+    void* allocate(size_t n, size_t align) { return r->allocate(n, align); }
+    void  deallocate(void* p, size_t n) { r->deallocate(p, n, natural_align(n)); }
+    void  deallocate(void* p, size_t n, size_t align) { r->deallocate(p, n, align); }
+    void* reallocate(void* p, size_t old_sz, size_t new_sz)
+    {
+        void* result = allocate(new_sz);
+        if (p != 0) {
+            memcpy(result, p, old_sz < new_sz ? old_sz : new_sz);
+            deallocate(p, old_sz);
+        }
+        return result;
+    }
+
+    memory_resource* resource() const { return r; }
+
+    bool operator== (const polymorphic_alloc& x) const { return *r == *x.r; }
+    bool operator!= (const polymorphic_alloc& x) const { return !(*this == x); }
+};
+
+template <>
+struct __alloc_equal<polymorphic_alloc> {
+    static bool equal(const polymorphic_alloc& a, const polymorphic_alloc& b) { return a == b; }
+};
+
+}
+
+#endif
@@ -0,0 +1,278 @@
+/* file		: mystl_mmap_vector.hpp
+ * by		: waterlemon	429426523@qq.com
+ * date		: Sun 18 Oct 2026 02:08:51 PM CST
+ * last update	:
+ *
+ * description	: mmap_vector
+ * mmap_vector<T> 的元素存放在映射到内存的文件中，接口与 vector 相同，迭代器也是普通指针。
+ * 打开已有的文件不需要读入任何元素，页面由操作系统按需载入，page cache 就是缓冲区；
+ * 数据集可以大于内存。扩充空间时加长文件并重新映射。
+ * 只适用于可以逐字节复制的型别 (trivially copyable)，元素不经过构造与析构。
+ *      mmap_vector<record> v("records.dat");
+ *      v.advise(mmap_vector<record>::sequential);
+ *      for (record* p = v.begin(); p != v.end(); ++p) ...
+ *
+ * 文件的前 __MMAP_HEADER_BYTES 字节是文件头，记录元素大小与个数，之后是元素。
+ * 文件长度即容量，可能大于 size()。
+ * 仅适用于 POSIX 系统。
+ */
+
+#ifndef     _MYSTL_MMAP_VECTOR_
+#define     _MYSTL_MMAP_VECTOR_
+
+#include "mystl_algobase.hpp"   /* fill() */
+#include "mystl_vector.hpp"     /* growth_x2{} */
+
+#include <cstddef>              /* size_t, ptrdiff_t */
+#include <cstring>              /* memmove() */
+#include <cerrno>               /* errno */
+#include <stdexcept>            /* std::runtime_error */
+#include <system_error>         /* std::system_error */
+#include <type_traits>          /* std::is_trivially_copyable<> */
+
+#include <fcntl.h>              /* open() */
+#include <unistd.h>             /* close(), ftruncate(), sysconf() */
+#include <sys/mman.h>           /* mmap(), munmap(), mremap(), msync(), madvise() */
+#include <sys/stat.h>           /* fstat() */
+
+namespace mystl
+{
+
+enum { __MMAP_HEADER_BYTES = 64 };          /* 文件头大小，也是元素的起始偏移 */
+enum { __MMAP_MAGIC = 0x6d6d7663 };         /* "mmvc" */
+
+struct __mmap_header {
+    unsigned int    magic;
+    unsigned int    elem_size;
+    size_t          count;                  /* 元素个数 */
+};
+
+template <typename T, typename Growth = growth_x2>
+class mmap_vector {
+    static_assert(std::is_trivially_copyable<T>::value,
+            "mmap_vector requires a trivially copyable element type");
+    static_assert(alignof(T) <= (size_t) __MMAP_HEADER_BYTES,
+            "mmap_vector element alignment exceeds the file header size");
+
+public:
+    typedef T                               value_type;
+    typedef T*                              pointer;
+    typedef T&                              reference;
+    typedef ptrdiff_t                       difference_type;
+    typedef size_t                          size_type;
+    typedef value_type*                     iterator;   /* 与 vector 相同，是普通指针 */
+
+    /* advise() 的参数，对应 madvise() 的 MADV_* */
+    enum access_hint {
+        normal      = MADV_NORMAL,
+        sequential  = MADV_SEQUENTIAL,
+        random      = MADV_RANDOM,
+        willneed    = MADV_WILLNEED,
+        dontneed    = MADV_DONTNEED
+    };
+
+protected:
+    int     fd;
+    char*   base;               /* 映射的起始地址，即文件头 */
+    size_t  mapped;             /* 映射的字节数，等于文件长度 */
+    iterator start;             /* 目前使用空间的头 */
+    iterator finish;            /* 目前使用空间的尾 */
+    iterator end_of_storage;    /* 目前可用空间的尾 */
+
+    /* 禁止复制 */
+    mmap_vector(const mmap_vector&);
+    mmap_vector& operator= (const mmap_vector&);
+
+    __mmap_header* header() { return (__mmap_header*) base; }
+
+    static void throw_errno(const char* what)
+    {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    static size_t page_size()
+    {
+        static const size_t sz = (size_t) sysconf(_SC_PAGESIZE);
+        return sz;
+    }
+    /* 容纳 n 个元素所需的文件长度，上调至整页 */
+    static size_t file_bytes(size_type n)
+    {
+        size_t bytes = __MMAP_HEADER_BYTES + n * sizeof (T);
+        return (bytes + page_size() - 1) & ~(page_size() - 1);
+    }
+
+    /* base 或 mapped 改变之后，重新计算三个指针 */
+    void reset_pointers(size_type n)
+    {
+        start = (iterator) (base + __MMAP_HEADER_BYTES);
+        finish = start + n;
+        end_of_storage = start + (mapped - __MMAP_HEADER_BYTES) / sizeof (T);
+    }
+    void set_size(size_type n)
+    {
+        finish = start + n;
+        header()->count = n;
+    }
+
+    /* 把文件改为 new_bytes 字节并重新映射，原有内容保持不变 */
+    void remap(size_t new_bytes)
+    {
+        const size_type n = size();
+        if (ftruncate(fd, (off_t) new_bytes) != 0)
+            throw_errno("mmap_vector: ftruncate");
+#ifdef __linux__
+        void* p = mremap(base, mapped, new_bytes, MREMAP_MAYMOVE);
+        if (p == MAP_FAILED)
+            throw_errno("mmap_vector: mremap");
+#else
+        void* p = mmap(0, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED)
+            throw_errno("mmap_vector: mmap");
+        munmap(base, mapped);
+#endif
+        base = (char*) p;
+        mapped = new_bytes;
+        reset_pointers(n);
+    }
+
+    void close_file()
+    {
+        if (base)
+            munmap(base, mapped);
+        if (fd >= 0)
+            ::close(fd);
+        base = 0;
+        fd = -1;
+    }
+
+public:
+    iterator begin() { return start; }
+    iterator end() { return finish; }
+    size_type size() { return size_type(end() - begin()); }
+    size_type capacity() { return size_type(end_of_storage - begin()); }
+    bool empty() { return begin() == end(); }
+    reference operator[] (size_type n) { return *(begin() + n); }
+    reference front() { return *begin(); }
+    reference back() { return *(end() - 1); }
+
+public:
+    /* 打开 path，文件不存在时建立一个空的 mmap_vector。
+     * 文件不是由相同大小的元素建立时抛出 std::runtime_error，系统调用失败时抛出 std::system_error */
+    explicit mmap_vector(const char* path)
+        : fd(-1), base(0), mapped(0), start(0), finish(0), end_of_storage(0)
+    {
+        fd = ::open(path, O_RDWR | O_CREAT, 0644);
+        if (fd < 0)
+            throw_errno("mmap_vector: open");
+        try {
+            struct stat st;
+            if (fstat(fd, &st) != 0)
+                throw_errno("mmap_vector: fstat");
+            bool fresh = st.st_size == 0;
+            if (fresh) {
+                mapped = file_bytes(0);
+                if (ftruncate(fd, (off_t) mapped) != 0)
+                    throw_errno("mmap_vector: ftruncate");
+            }
+            else if ((size_t) st.st_size < (size_t) __MMAP_HEADER_BYTES)
+                throw std::runtime_error("mmap_vector: file too short");
+            else
+                mapped = (size_t) st.st_size;
+
+            void* p = mmap(0, mapped, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (p == MAP_FAILED)
+                throw_errno("mmap_vector: mmap");
+            base = (char*) p;
+
+            if (fresh) {
+                header()->magic = __MMAP_MAGIC;
+                header()->elem_size = sizeof (T);
+                header()->count = 0;
+            }
+            else if (header()->magic != (unsigned int) __MMAP_MAGIC ||
+                    header()->elem_size != sizeof (T) ||
+                    header()->count > (mapped - __MMAP_HEADER_BYTES) / sizeof (T))
+                throw std::runtime_error("mmap_vector: bad file header");
+            reset_pointers(header()->count);
+        } catch (...) {
+            close_file();
+            throw;
+        }
+    }
+    mmap_vector(mmap_vector&& x)
+        : fd(x.fd), base(x.base), mapped(x.mapped),
+          start(x.start), finish(x.finish), end_of_storage(x.end_of_storage)
+    {
+        x.fd = -1;
+        x.base = 0;
+        x.mapped = 0;
+        x.start = x.finish = x.end_of_storage = 0;
+    }
+    /* 解除映射并关闭文件。修改由操作系统写回，需要确定落盘时先调用 sync() */
+    ~mmap_vector() { close_file(); }
+
+public:
+    void reserve(size_type n)
+    {
+        if (n > capacity())
+            remap(file_bytes(n));
+    }
+    /* 把文件缩短到刚好容纳 size() 个元素 */
+    void shrink_to_fit()
+    {
+        if (file_bytes(size()) < mapped)
+            remap(file_bytes(size()));
+    }
+
+    void push_back(const T& x)
+    {
+        if (finish == end_of_storage) {
+            const T x_copy = x;             /* x 可能是本容器中的元素 */
+            remap(file_bytes(Growth::next_capacity(capacity(), size() + 1, sizeof (T))));
+            *finish = x_copy;
+        }
+        else
+            *finish = x;
+        set_size(size() + 1);
+    }
+    void pop_back() { set_size(size() - 1); }
+
+    iterator erase(iterator first, iterator last)
+    {
+        memmove((void*) first, (void*) last, sizeof (T) * (finish - last));
+        set_size(size() - (last - first));
+        return first;
+    }
+    iterator erase(iterator position) { return erase(position, position + 1); }
+
+    void resize(size_type new_size, const T& x)
+    {
+        const size_type old_size = size();
+        if (new_size > old_size) {
+            const T x_copy = x;
+            reserve(new_size);
+            mystl::fill(start + old_size, start + new_size, x_copy);
+        }
+        set_size(new_size);
+    }
+    void resize(size_type new_size) { resize(new_size, T()); }
+    void clear() { set_size(0); }
+
+    /* 把修改写回文件: async 为 false 时等待写回完成 */
+    void sync(bool async = false)
+    {
+        if (msync(base, mapped, async ? MS_ASYNC : MS_SYNC) != 0)
+            throw_errno("mmap_vector: msync");
+    }
+    /* 告诉操作系统接下来的存取方式，例如顺序扫描前使用 sequential */
+    void advise(access_hint hint)
+    {
+        if (madvise(base, mapped, (int) hint) != 0)
+            throw_errno("mmap_vector: madvise");
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,224 @@
+/* file		: mystl_slab_alloc.hpp
+ * by		: waterlemon	429426523@qq.com
+ * date		: Sun 18 Oct 2026 04:21:33 PM CST
+ * last update	:
+ *
+ * description	: slab_alloc, static_slab_alloc
+ * 为 list 这类每次只配置一个结点的容器准备的配置器。
+ * 结点从大块 (slab) 中成批切出，同一个 slab 的结点在内存中相邻，遍历时局部性较好；
+ * 释放的结点放进 free-list 重复使用，slab 在配置器析构时整块归还。
+ *
+ *  (1) 每个容器一个 slab: slab_alloc 由容器通过 __alloc_holder 持有，随容器一起析构
+ *      list<int, slab_alloc<> > l;
+ *  (2) 每个型别一个 slab: static_slab_alloc<Tag> 的所有容器共享一个 slab_alloc，
+ *      Tag 只用来区分不同的 slab，例如使用元素型别
+ *      list<int, static_slab_alloc<int> > l;
+ * 都没有加锁，只适合在一个线程中使用。
+ */
+
+#ifndef     _MYSTL_SLAB_ALLOC_
+#define     _MYSTL_SLAB_ALLOC_
+
+#include "mystl_alloc.hpp"      /* alloc{}, __alloc_reserve{}, __alloc_equal{}, __MAX_ALIGN */
+
+#include <cstring>              /* memcpy() */
+#include <cstddef>              /* size_t */
+#include <utility>              /* std::swap() */
+
+namespace mystl
+{
+
+enum { __SLAB_MIN_OBJS = 16 };      /* 第一个 slab 的结点数 */
+enum { __SLAB_MAX_OBJS = 1024 };    /* 之后每次加倍，直到这个上限 */
+
+/* 只管理一种大小的区块: 第一次配置的大小就是 slab 的区块大小，
+ * 其他大小的请求 (如 list 以外的用途) 直接交给 Alloc */
+template <typename Alloc = alloc>
+class slab_alloc : private Alloc {
+private:
+    union obj {
+        union obj* free_list_link;
+        char client_data[1];
+    };
+    /* 每个 slab 的头部，之后是结点 */
+    struct slab {
+        slab*   next;
+        size_t  size;           /* 包括头部在内的大小 */
+    };
+
+    enum { __HEADER = (sizeof (slab) + __MAX_ALIGN - 1) & ~(__MAX_ALIGN - 1) };
+
+    obj*    free_list;
+    size_t  free_count;         /* free-list 上的区块数 */
+    slab*   slabs;              /* 已配置的 slab，最新的在前 */
+    size_t  obj_size;           /* 0 表示还没有配置过 */
+    size_t  next_objs;          /* 下一个 slab 的结点数 */
+
+    Alloc& base() { return *this; }
+
+    void init()
+    {
+        free_list = 0;
+        free_count = 0;
+        slabs = 0;
+        obj_size = 0;
+        next_objs = __SLAB_MIN_OBJS;
+    }
+
+    /* 配置一个容纳 nobjs 个区块的 slab，按地址顺序串进 free-list 的前端，
+     * 于是接下来配置的结点在内存中依次相邻 */
+    void refill(size_t nobjs)
+    {
+        size_t sz = __HEADER + nobjs * obj_size;
+        slab* s = (slab*) base().allocate(sz);
+        s->next = slabs;
+        s->size = sz;
+        slabs = s;
+
+        char* p = (char*) s + __HEADER + (nobjs - 1) * obj_size;
+        for (size_t i = 0; i < nobjs; i++, p -= obj_size) {
+            ((obj*) p)->free_list_link = free_list;
+            free_list = (obj*) p;
+        }
+        free_count += nobjs;
+    }
+
+    static size_t round_up(size_t n) { return n < sizeof (obj) ? sizeof (obj) : n; }
+    bool is_slab_size(size_t n)
+    {
+        if (obj_size == 0)
+            obj_size = round_up(n);
+        return round_up(n) == obj_size;
+    }
+
+public:
+    slab_alloc() { init(); }
+    slab_alloc(const Alloc& a) : Alloc(a) { init(); }
+    /* slab 属于配置器对象本身: 复制得到的是一个空的 slab_alloc */
+    slab_alloc(const slab_alloc& x) : Alloc(x) { init(); }
+    slab_alloc(slab_alloc&& x) : Alloc(x)
+    {
+        init();
+        swap(x);
+    }
+    /* 复制赋值保留自己的 slab (容器的复制赋值不转移元素)；
+     * 移动赋值与交换相同，供容器的 swap() 使用 */
+    slab_alloc& operator= (const slab_alloc& /* x */) { return *this; }
+    slab_alloc& operator= (slab_alloc&& x)
+    {
+        swap(x);
+        return *this;
+    }
+    ~slab_alloc() { release(); }
+
+    void swap(slab_alloc& x)
+    {
+        std::swap(base(), x.base());
+        std::swap(free_list, x.free_list);
+        std::swap(free_count, x.free_count);
+        std::swap(slabs, x.slabs);
+        std::swap(obj_size, x.obj_size);
+        std::swap(next_objs, x.next_objs);
+    }
+
+    void* allocate(size_t n)
+    {
+        if (!is_slab_size(n))
+            return base().allocate(n);
+        if (free_list == 0) {
+            refill(next_objs);
+            if (next_objs < (size_t) __SLAB_MAX_OBJS)
+                next_objs *= 2;
+        }
+        obj* result = free_list;
+        free_list = result->free_list_link;
+        --free_count;
+        return result;
+    }
+    void deallocate(void* p, size_t n)
+    {
+        if (!is_slab_size(n)) {
+            base().deallocate(p, n);
+            return;
+        }
+        obj* q = (obj*) p;
+        q->free_list_link = free_list;
+        free_list = q;
+        ++free_count;
+    }
+    /* slab 只保证 __MAX_ALIGN 以内的结点自然对齐，对齐版本直接交给 Alloc */
+    void* allocate(size_t n, size_t align) { return base().allocate(n, align); }
+    void  deallocate(void* p, size_t n, size_t align) { base().deallocate(p, n, align); }
+    void* reallocate(void* p, size_t old_sz, size_t new_sz)
+    {
+        if (!is_slab_size(old_sz) && !is_slab_size(new_sz))
+            return base().reallocate(p, old_sz, new_sz);
+        void* result = allocate(new_sz);
+        memcpy(result, p, old_sz < new_sz ? old_sz : new_sz);
+        deallocate(p, old_sz);
+        return result;
+    }
+
+    /* 确保 free-list 上至少有 n 个大小为 size 的区块，不足的部分以一个 slab 补齐 */
+    void reserve(size_t n, size_t size)
+    {
+        if (is_slab_size(size) && n > free_count)
+            refill(n - free_count);
+    }
+
+    /* 归还所有 slab，之前配置的区块全部失效 */
+    void release()
+    {
+        while (slabs) {
+            slab* next = slabs->next;
+            base().deallocate(slabs, slabs->size);
+            slabs = next;
+        }
+        init();
+    }
+
+    /* 每个 slab_alloc 对象各有自己的 slab */
+    bool operator== (const slab_alloc& x) const { return this == &x; }
+    bool operator!= (const slab_alloc& x) const { return this != &x; }
+};
+
+template <typename Alloc>
+struct __alloc_reserve<slab_alloc<Alloc> > {
+    static void reserve(slab_alloc<Alloc>& a, size_t n, size_t size) { a.reserve(n, size); }
+};
+
+template <typename Alloc>
+struct __alloc_equal<slab_alloc<Alloc> > {
+    static bool equal(const slab_alloc<Alloc>& a, const slab_alloc<Alloc>& b) { return a == b; }
+};
+
+/* 同一个 Tag 的所有容器共享一个 slab_alloc，它在第一次使用时建立，程序结束时析构 */
+template <typename Tag, typename Alloc = alloc>
+class static_slab_alloc {
+private:
+    static slab_alloc<Alloc>& pool()
+    {
+        static slab_alloc<Alloc> p;
+        return p;
+    }
+
+public:
+    static void* allocate(size_t n) { return pool().allocate(n); }
+    static void  deallocate(void* p, size_t n) { pool().deallocate(p, n); }
+    static void* allocate(size_t n, size_t align) { return pool().allocate(n, align); }
+    static void  deallocate(void* p, size_t n, size_t align) { pool().deallocate(p, n, align); }
+    static void* reallocate(void* p, size_t old_sz, size_t new_sz)
+        { return pool().reallocate(p, old_sz, new_sz); }
+
+    static void reserve(size_t n, size_t size) { pool().reserve(n, size); }
+};
+
+template <typename Tag, typename Alloc>
+struct __alloc_reserve<static_slab_alloc<Tag, Alloc> > {
+    static void reserve(static_slab_alloc<Tag, Alloc>& /* a */, size_t n, size_t size)
+        { static_slab_alloc<Tag, Alloc>::reserve(n, size); }
+};
+
+}
+
+#endif
@@ -0,0 +1,438 @@
+/* file		: mystl_slist.hpp
+ * by		: waterlemon	429426523@qq.com
+ * date		: Sun 18 Oct 2026 07:03:56 PM CST
+ * last update	:
+ *
+ * description	: slist
+ * slist 是单向链表，结点只有 next 指针，比 list 的结点少一个指针，插入与删除也少一次写入。
+ * 迭代器是 forward iterator，只能往后走，所以插入与删除都作用在给定位置的 "之后":
+ *      slist<int> s;
+ *      s.push_front(1);
+ *      s.insert_after(s.before_begin(), 0);
+ *      s.erase_after(s.begin());
+ *
+ * 为了让 splice_after() 是 O(1)，slist 不记录元素个数，size() 是 O(n)。
+ * 结点与 list 一样通过 simple_alloc 配置，可以搭配 slab_alloc 使用。
+ */
+
+#ifndef     _MYSTL_SLIST_
+#define     _MYSTL_SLIST_
+
+#include "mystl_alloc.hpp"      /* alloc{}, simple_alloc{}, __alloc_holder{}, __alloc_reserve{} */
+#include "mystl_iterator.hpp"   /* forward_iterator_tag{}, distance() */
+#include "mystl_construct.hpp"  /* construct(), destroy() */
+#include "mystl_list.hpp"       /* __list_less{}, __list_equal_to{} */
+
+#include <cstddef>              /* size_t, ptrdiff_t */
+#include <utility>              /* std::move(), std::forward(), std::swap() */
+
+namespace mystl
+{
+
+/* slist结点: 链接部分与元素分开，头结点只有链接部分 */
+struct __slist_node_base {
+    __slist_node_base* next;
+};
+
+template <typename T>
+struct __slist_node : public __slist_node_base {
+    T data;
+};
+
+/* 把 new_node 接在 prev_node 之后 */
+inline __slist_node_base* __slist_make_link(__slist_node_base* prev_node,
+        __slist_node_base* new_node)
+{
+    new_node->next = prev_node->next;
+    prev_node->next = new_node;
+    return new_node;
+}
+
+/* 从 head 开始找 node 的前一个结点，O(n) */
+inline __slist_node_base* __slist_previous(__slist_node_base* head,
+        const __slist_node_base* node)
+{
+    while (head && head->next != node)
+        head = head->next;
+    return head;
+}
+
+/* 把 (before_first, before_last] 移到 pos 之后，只修改三个指针 */
+inline void __slist_splice_after(__slist_node_base* pos,
+        __slist_node_base* before_first, __slist_node_base* before_last)
+{
+    if (pos != before_first && pos != before_last) {
+        __slist_node_base* first = before_first->next;
+        __slist_node_base* after = pos->next;
+        before_first->next = before_last->next;
+        pos->next = first;
+        before_last->next = after;
+    }
+}
+
+/* 逆置以 0 结尾的链，返回新的第一个结点 */
+inline __slist_node_base* __slist_reverse(__slist_node_base* node)
+{
+    __slist_node_base* result = 0;
+    while (node) {
+        __slist_node_base* next = node->next;
+        node->next = result;
+        result = node;
+        node = next;
+    }
+    return result;
+}
+
+/* slist迭代器: __slist_iterator */
+template <typename T, typename Ref, typename Ptr>
+struct __slist_iterator {
+    typedef __slist_iterator<T, T&, T*>     iterator;
+    typedef __slist_iterator<T, Ref, Ptr>   self;
+
+    typedef forward_iterator_tag            iterator_category;
+    typedef T                               value_type;
+    typedef Ptr                             pointer;
+    typedef Ref                             reference;
+    typedef ptrdiff_t                       difference_type;
+    typedef size_t                          size_type;
+
+    typedef __slist_node_base*              base_ptr;
+    typedef __slist_node<T>*                link_type;
+
+    base_ptr node;      /* end() 为 0 */
+
+    __slist_iterator(base_ptr x) : node(x) {}
+    __slist_iterator() : node(0) {}
+    __slist_iterator(const iterator& x) : node(x.node) {}
+
+    bool operator== (const self& x) const { return node == x.node; }
+    bool operator!= (const self& x) const { return node != x.node; }
+
+    reference operator* () const { return ((link_type) node)->data; }
+    pointer operator-> () const { return &(operator*()); }
+
+    self& operator++ ()
+    {
+        node = node->next;
+        return *this;
+    }
+    self operator++ (int)
+    {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+};
+
+/* 头结点放在 slist 对象内部，最后一个结点的 next 为 0 */
+template <typename T, typename Alloc = alloc>
+class slist : protected __alloc_holder<Alloc> {
+public:
+    typedef T                               value_type;
+    typedef T*                              pointer;
+    typedef T&                              reference;
+    typedef const T&                        const_reference;
+    typedef ptrdiff_t                       difference_type;
+    typedef size_t                          size_type;
+    typedef __slist_iterator<T, T&, T*>     iterator;
+    typedef Alloc                           allocator_type;
+
+protected:
+    typedef __alloc_holder<Alloc>           alloc_base;
+    typedef __slist_node_base               node_base;
+    typedef __slist_node<T>                 list_node;
+    typedef list_node*                      link_type;
+    typedef simple_alloc<list_node, Alloc>  list_node_allocator;
+
+    node_base head;
+
+    /* 空间配置 */
+    link_type get_node() { return list_node_allocator::allocate(this->allocator()); }
+    void put_node(link_type p) { list_node_allocator::deallocate(this->allocator(), p); }
+
+    template <typename... Args>
+    link_type create_node(Args&&... args)
+    {
+        link_type p = get_node();
+        try {
+            mystl::construct(&p->data, std::forward<Args>(args)...);
+        } catch (...) {
+            put_node(p);
+            throw;
+        }
+        p->next = 0;
+        return p;
+    }
+    void destroy_node(link_type p)
+    {
+        mystl::destroy(&p->data);
+        put_node(p);
+    }
+
+    /* 删除 pos 之后的一个结点，返回被删结点的下一个 */
+    node_base* erase_after(node_base* pos)
+    {
+        link_type next = (link_type) pos->next;
+        pos->next = next->next;
+        destroy_node(next);
+        return pos->next;
+    }
+    /* 删除 (before_first, last) */
+    node_base* erase_after(node_base* before_first, node_base* last)
+    {
+        link_type cur = (link_type) before_first->next;
+        while (cur != last) {
+            link_type tmp = cur;
+            cur = (link_type) cur->next;
+            destroy_node(tmp);
+        }
+        before_first->next = last;
+        return last;
+    }
+
+    /* 把 x 的元素依次接在 pos 之后，返回最后一个新结点 */
+    node_base* insert_range_after(node_base* pos, const slist& x)
+    {
+        for (node_base* p = x.head.next; p; p = p->next)
+            pos = __slist_make_link(pos, create_node(((link_type) p)->data));
+        return pos;
+    }
+
+    /* 合并两条以 0 结尾、已排序的链，与 list 相同，相等时 a 的元素在前 */
+    template <typename Compare>
+    static node_base* merge_chains(node_base* a, node_base* b, Compare comp)
+    {
+        node_base result;
+        node_base* tail = &result;
+        while (a && b) {
+            if (comp(((link_type) b)->data, ((link_type) a)->data)) {
+                tail->next = b;
+                b = b->next;
+            }
+            else {
+                tail->next = a;
+                a = a->next;
+            }
+            tail = tail->next;
+        }
+        tail->next = a ? a : b;
+        return result.next;
+    }
+
+public:
+    iterator before_begin() { return &head; }
+    iterator begin() { return head.next; }
+    iterator end() { return iterator(0); }
+    bool empty() { return head.next == 0; }
+    /* 需要走过整个链表 */
+    size_type size() { return mystl::distance(begin(), end()); }
+    reference front() { return ((link_type) head.next)->data; }
+
+    /* pos 的前一个位置，O(n) */
+    iterator previous(iterator pos) { return __slist_previous(&head, pos.node); }
+
+    using alloc_base::get_allocator;
+
+public:
+    slist() { head.next = 0; }
+    explicit slist(const Alloc& a) : alloc_base(a) { head.next = 0; }
+    slist(size_type n, const T& value, const Alloc& a = Alloc()) : alloc_base(a)
+    {
+        head.next = 0;
+        __alloc_reserve<Alloc>::reserve(this->allocator(), n, sizeof (list_node));
+        try {
+            node_base* pos = &head;
+            while (n--)
+                pos = __slist_make_link(pos, create_node(value));
+        } catch (...) {
+            clear();
+            throw;
+        }
+    }
+    slist(const slist& x) : alloc_base(x.get_allocator())
+    {
+        head.next = 0;
+        try {
+            insert_range_after(&head, x);
+        } catch (...) {
+            clear();
+            throw;
+        }
+    }
+    /* 移动构造: 接管 x 的所有结点 */
+    slist(slist&& x) : alloc_base(x.get_allocator())
+    {
+        head.next = 0;
+        swap(x);
+    }
+    /* 复制赋值: 先赋值给已有的结点，多余的删除，不足时再配置；配置器不随之复制 */
+    slist& operator= (const slist& x)
+    {
+        if (this != &x) {
+            node_base* p1 = &head;
+            node_base* p2 = x.head.next;
+            for (; p1->next && p2; p1 = p1->next, p2 = p2->next)
+                ((link_type) p1->next)->data = ((link_type) p2)->data;
+            if (p2 == 0)
+                erase_after(p1, 0);
+            else {
+                for (; p2; p2 = p2->next)
+                    p1 = __slist_make_link(p1, create_node(((link_type) p2)->data));
+            }
+        }
+        return *this;
+    }
+    slist& operator= (slist&& x)
+    {
+        if (this != &x) {
+            clear();
+            swap(x);
+        }
+        return *this;
+    }
+    ~slist() { clear(); }
+
+    /* 交换两个 slist 的结点与配置器，不复制任何元素 */
+    void swap(slist& x) noexcept
+    {
+        std::swap(this->allocator(), x.allocator());
+        std::swap(head.next, x.head.next);
+    }
+
+public:
+    void push_front(const T& x) { __slist_make_link(&head, create_node(x)); }
+    void push_front(T&& x) { __slist_make_link(&head, create_node(std::move(x))); }
+    template <typename... Args>
+    void emplace_front(Args&&... args)
+    {
+        __slist_make_link(&head, create_node(std::forward<Args>(args)...));
+    }
+    void pop_front() { erase_after(&head); }
+
+    /* 在 pos 之后插入，返回新元素的位置 */
+    iterator insert_after(iterator pos, const T& x)
+    {
+        return __slist_make_link(pos.node, create_node(x));
+    }
+    iterator insert_after(iterator pos, T&& x)
+    {
+        return __slist_make_link(pos.node, create_node(std::move(x)));
+    }
+    template <typename... Args>
+    iterator emplace_after(iterator pos, Args&&... args)
+    {
+        return __slist_make_link(pos.node, create_node(std::forward<Args>(args)...));
+    }
+
+    /* 删除 pos 之后的元素，返回被删元素的下一个位置 */
+    iterator erase_after(iterator pos) { return erase_after(pos.node); }
+    /* 删除 (before_first, last) */
+    iterator erase_after(iterator before_first, iterator last)
+    {
+        return erase_after(before_first.node, last.node);
+    }
+
+    void clear() { erase_after(&head, 0); }
+
+public:
+    /* 以下操作都只修改结点的指针，不配置空间，也不复制元素。
+     * 元素来自另一个 slist x 时，两者的配置器必须相等 */
+
+    /* 把 x 的全部元素移到 pos 之后。需要找到 x 的最后一个结点，是 O(x.size()) */
+    void splice_after(iterator pos, slist& x)
+    {
+        if (x.head.next) {
+            node_base* before_last = __slist_previous(&x.head, 0);
+            __slist_splice_after(pos.node, &x.head, before_last);
+        }
+    }
+    /* 把 prev 之后的一个元素移到 pos 之后，O(1) */
+    void splice_after(iterator pos, iterator prev)
+    {
+        if (prev.node->next)
+            __slist_splice_after(pos.node, prev.node, prev.node->next);
+    }
+    /* 把 (before_first, before_last] 移到 pos 之后，O(1)。
+     * pos 不可以在 (before_first, before_last] 之内 */
+    void splice_after(iterator pos, iterator before_first, iterator before_last)
+    {
+        if (before_first != before_last)
+            __slist_splice_after(pos.node, before_first.node, before_last.node);
+    }
+
+    void reverse()
+    {
+        if (head.next)
+            head.next = __slist_reverse(head.next);
+    }
+
+    /* 两个 slist 都已递增排序，把 x 合并进来，x 成为空 slist */
+    void merge(slist& x) { merge(x, __list_less()); }
+    template <typename Compare>
+    void merge(slist& x, Compare comp)
+    {
+        if (&x != this) {
+            head.next = merge_chains(head.next, x.head.next, comp);
+            x.head.next = 0;
+        }
+    }
+
+    /* 删除连续而相同的元素，只留第一个 */
+    void unique() { unique(__list_equal_to()); }
+    template <typename BinaryPredicate>
+    void unique(BinaryPredicate pred)
+    {
+        node_base* cur = head.next;
+        if (cur == 0)
+            return;
+        while (cur->next) {
+            if (pred(((link_type) cur)->data, ((link_type) cur->next)->data))
+                erase_after(cur);
+            else
+                cur = cur->next;
+        }
+    }
+
+    /* 与 list::sort() 相同的 bottom-up merge sort，稳定，不配置空间。
+     * 链本来就以 0 结尾，排序之后也不需要重建 prev 指针 */
+    void sort() { sort(__list_less()); }
+    template <typename Compare>
+    void sort(Compare comp)
+    {
+        if (head.next == 0 || head.next->next == 0)
+            return;
+
+        node_base* bins[sizeof (size_t) * 8];
+        int fill = 0;
+        node_base* node = head.next;
+        while (node) {
+            node_base* carry = node;
+            node = node->next;
+            carry->next = 0;
+            int i = 0;
+            for (; i < fill && bins[i]; i++) {
+                carry = merge_chains(bins[i], carry, comp);     /* bins[i] 的元素在前 */
+                bins[i] = 0;
+            }
+            bins[i] = carry;
+            if (i == fill)
+                ++fill;
+        }
+        node_base* result = 0;
+        for (int i = 0; i < fill; i++) {
+            if (bins[i])
+                result = result ? merge_chains(bins[i], result, comp) : bins[i];
+        }
+        head.next = result;
+    }
+};
+
+template <typename T, typename Alloc>
+inline void swap(slist<T, Alloc>& x, slist<T, Alloc>& y) noexcept
+{
+    x.swap(y);
+}
+
+}
+
+#endif
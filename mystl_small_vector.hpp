@@ -0,0 +1,301 @@
+/* file		: mystl_small_vector.hpp
+ * by		: waterlemon	429426523@qq.com
+ * date		: Sun 18 Oct 2026 10:14:27 AM CST
+ * last update	:
+ *
+ * description	: small_vector
+ * small_vector<T, N> 在对象内部保留 N 个元素的空间 (small-buffer optimization)，
+ * 元素个数不超过 N 时不配置任何空间，超过时才通过 simple_alloc 配置，之后与 vector 相同。
+ * 迭代器与 vector 一样是普通指针，mystl_algo.hpp 中的算法可以直接使用:
+ *      small_vector<int, 8> v;
+ *      v.push_back(1);             // 不配置空间
+ */
+
+#ifndef     _MYSTL_SMALL_VECTOR_
+#define     _MYSTL_SMALL_VECTOR_
+
+#include "mystl_alloc.hpp"      /* simple_alloc{}, alloc{}, __alloc_holder{} */
+#include "mystl_construct.hpp"  /* construct(), destroy() */
+#include "mystl_algobase.hpp"   /* copy(), move(), move_backward() */
+#include "mystl_uninitialized.hpp"  /* uninitialized_copy(), uninitialized_fill_n(),
+                                       uninitialized_move(), uninitialized_move_if_noexcept() */
+#include "mystl_vector.hpp"     /* growth_x2{} */
+
+#include <cstddef>              /* size_t, ptrdiff_t */
+#include <cstring>              /* memcpy() */
+#include <utility>              /* std::move(), std::forward() */
+#include <type_traits>          /* std::aligned_storage<> */
+
+namespace mystl
+{
+
+template <typename T, size_t N, typename Alloc = alloc, typename Growth = growth_x2>
+class small_vector : protected __alloc_holder<Alloc> {
+    static_assert(N > 0, "small_vector needs at least one inline element");
+
+public:
+    typedef T                               value_type;
+    typedef T*                              pointer;
+    typedef T&                              reference;
+    typedef ptrdiff_t                       difference_type;
+    typedef size_t                          size_type;
+    typedef value_type*                     iterator;   /* 与 vector 相同，是普通指针 */
+    typedef Alloc                           allocator_type;
+
+    enum { inline_capacity = N };
+
+protected:
+    typedef __alloc_holder<Alloc>           alloc_base;
+    typedef simple_alloc<value_type, Alloc> data_allocator;
+    typedef typename __type_traits<T>::is_trivially_relocatable relocatable;
+
+    iterator start;             /* 目前使用空间的头 */
+    iterator finish;            /* 目前使用空间的尾 */
+    iterator end_of_storage;    /* 目前可用空间的尾 */
+    typename std::aligned_storage<sizeof (T) * N, alignof(T)>::type buf;   /* 内部空间 */
+
+    iterator inline_storage() { return (iterator) &buf; }
+    bool is_inline() { return start == inline_storage(); }
+
+    void reset_inline()
+    {
+        start = finish = inline_storage();
+        end_of_storage = start + N;
+    }
+    void deallocate()
+    {
+        if (!is_inline())
+            data_allocator::deallocate(this->allocator(), start, end_of_storage - start);
+    }
+
+    /* 把 [first, last) 搬到未初始化的 result 处，原位置的元素不再存在 */
+    static iterator relocate(iterator first, iterator last, iterator result, __true_type)
+    {
+        memcpy((void*) result, (void*) first, sizeof (T) * (last - first));
+        return result + (last - first);
+    }
+    static iterator relocate(iterator first, iterator last, iterator result, __false_type)
+    {
+        iterator r = mystl::uninitialized_move_if_noexcept(first, last, result);
+        mystl::destroy(first, last);
+        return r;
+    }
+
+    /* 把容量扩充为 new_cap (> capacity())，元素搬到新配置的空间 */
+    void grow(size_type new_cap)
+    {
+        iterator new_start = data_allocator::allocate(this->allocator(), new_cap);
+        iterator new_finish;
+        try {
+            new_finish = relocate(start, finish, new_start, relocatable());
+        } catch (...) {
+            data_allocator::deallocate(this->allocator(), new_start, new_cap);
+            throw;
+        }
+        deallocate();
+        start = new_start;
+        finish = new_finish;
+        end_of_storage = new_start + new_cap;
+    }
+    size_type next_capacity(size_type n)
+    {
+        return Growth::next_capacity(capacity(), size() + n, sizeof (T));
+    }
+
+    /* 空间已满时在尾端以 args 构造元素: 先在新空间构造 (args 可能引用本容器中的元素)，
+     * 再把原有元素搬过去 */
+    template <typename... Args>
+    void realloc_emplace_back(Args&&... args)
+    {
+        const size_type new_cap = next_capacity(1);
+        iterator new_start = data_allocator::allocate(this->allocator(), new_cap);
+        iterator new_pos = new_start + size();
+        try {
+            mystl::construct(new_pos, std::forward<Args>(args)...);
+        } catch (...) {
+            data_allocator::deallocate(this->allocator(), new_start, new_cap);
+            throw;
+        }
+        try {
+            relocate(start, finish, new_start, relocatable());
+        } catch (...) {
+            mystl::destroy(new_pos);
+            data_allocator::deallocate(this->allocator(), new_start, new_cap);
+            throw;
+        }
+        deallocate();
+        start = new_start;
+        finish = new_pos + 1;
+        end_of_storage = new_start + new_cap;
+    }
+
+public:
+    iterator begin() { return start; }
+    iterator end() { return finish; }
+    size_type size() { return size_type(end() - begin()); }
+    size_type capacity() { return size_type(end_of_storage - begin()); }
+    bool empty() { return begin() == end(); }
+    reference operator[] (size_type n) { return *(begin() + n); }
+    reference front() { return *begin(); }
+    reference back() { return *(end() - 1); }
+
+    using alloc_base::get_allocator;
+
+public:
+    small_vector() { reset_inline(); }
+    explicit small_vector(const Alloc& a) : alloc_base(a) { reset_inline(); }
+    small_vector(size_type n, const T& value, const Alloc& a = Alloc()) : alloc_base(a)
+    {
+        reset_inline();
+        if (n > N) {
+            start = finish = data_allocator::allocate(this->allocator(), n);
+            end_of_storage = start + n;
+        }
+        try {
+            finish = mystl::uninitialized_fill_n(start, n, value);
+        } catch (...) {
+            deallocate();
+            throw;
+        }
+    }
+    small_vector(const small_vector& x) : alloc_base(x.get_allocator())
+    {
+        reset_inline();
+        const size_type n = x.finish - x.start;
+        if (n > N) {
+            start = finish = data_allocator::allocate(this->allocator(), n);
+            end_of_storage = start + n;
+        }
+        try {
+            finish = mystl::uninitialized_copy(x.start, x.finish, start);
+        } catch (...) {
+            deallocate();
+            throw;
+        }
+    }
+    /* x 使用配置的空间时直接接管，使用内部空间时逐个移动元素 */
+    small_vector(small_vector&& x) : alloc_base(std::move(x.allocator()))
+    {
+        reset_inline();
+        take(x);
+    }
+    small_vector& operator= (const small_vector& x)
+    {
+        if (this != &x) {
+            clear();
+            reserve(x.finish - x.start);
+            finish = mystl::uninitialized_copy(x.start, x.finish, start);
+        }
+        return *this;
+    }
+    small_vector& operator= (small_vector&& x)
+    {
+        if (this != &x) {
+            clear();
+            deallocate();
+            reset_inline();
+            this->allocator() = std::move(x.allocator());
+            take(x);
+        }
+        return *this;
+    }
+    ~small_vector()
+    {
+        mystl::destroy(start, finish);
+        deallocate();
+    }
+
+protected:
+    /* *this 为空且使用内部空间 */
+    void take(small_vector& x)
+    {
+        if (!x.is_inline()) {
+            start = x.start;
+            finish = x.finish;
+            end_of_storage = x.end_of_storage;
+            x.reset_inline();
+        }
+        else {
+            finish = mystl::uninitialized_move(x.start, x.finish, start);
+            x.clear();
+        }
+    }
+
+public:
+    void reserve(size_type n)
+    {
+        if (n > capacity())
+            grow(n);
+    }
+
+    void push_back(const T& x) { emplace_back(x); }
+    void push_back(T&& x) { emplace_back(std::move(x)); }
+    template <typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        if (finish != end_of_storage) {
+            mystl::construct(finish, std::forward<Args>(args)...);
+            ++finish;
+        }
+        else
+            realloc_emplace_back(std::forward<Args>(args)...);
+    }
+    void pop_back()
+    {
+        --finish;
+        mystl::destroy(finish);
+    }
+
+    iterator insert(iterator position, const T& x) { return emplace(position, x); }
+    iterator insert(iterator position, T&& x) { return emplace(position, std::move(x)); }
+    template <typename... Args>
+    iterator emplace(iterator position, Args&&... args)
+    {
+        const size_type elems_before = position - start;
+        if (position == finish) {
+            emplace_back(std::forward<Args>(args)...);
+            return start + elems_before;
+        }
+        T x_copy(std::forward<Args>(args)...);  /* args 可能引用本容器中的元素 */
+        if (finish == end_of_storage)
+            grow(next_capacity(1));
+        position = start + elems_before;
+        mystl::construct(finish, std::move(*(finish-1)));
+        ++finish;
+        mystl::move_backward(position, finish-2, finish-1);
+        *position = std::move(x_copy);
+        return position;
+    }
+
+    iterator erase(iterator position)
+    {
+        if (position == end())
+            return position;
+        return erase(position, position + 1);
+    }
+    iterator erase(iterator first, iterator last)
+    {
+        if (first == last)      /* 否则每个元素都要移动赋值给自己 */
+            return first;
+        iterator i = mystl::move(last, finish, first);
+        mystl::destroy(i, finish);
+        finish = i;
+        return first;
+    }
+    void resize(size_type new_size, const T& x)
+    {
+        if (new_size < size())
+            erase(begin() + new_size, end());
+        else {
+            const T x_copy = x;
+            reserve(new_size);
+            finish = mystl::uninitialized_fill_n(finish, new_size - size(), x_copy);
+        }
+    }
+    void resize(size_type new_size) { resize(new_size, T()); }
+    void clear() { erase(begin(), end()); }
+};
+
+}
+
+#endif
@@ -0,0 +1,355 @@
+/* file		: mystl_thread_alloc.hpp
+ * by		: waterlemon	429426523@qq.com
+ * date		: Sat 17 Oct 2026 09:40:12 AM CST
+ * last update	:
+ *
+ * description	: thread_alloc
+ * 多线程下的小区块配置器。每个线程持有自己的 free-list (thread cache)，
+ * 小区块的配置和回收在本线程内完成，不需要加锁；
+ * 线程之间通过中央仓库 (depot) 以批 (batch) 为单位交换区块，depot 是无锁的；
+ * depot 放满之后，多出来的批放进以 mutex 保护的 overflow 链，区块不会被丢弃。
+ * 用法: vector<T, thread_alloc>, list<T, thread_alloc>
+ */
+
+#ifndef     _MYSTL_THREAD_ALLOC_
+#define     _MYSTL_THREAD_ALLOC_
+
+#include "mystl_alloc.hpp"      /* malloc_alloc{}, __ALIGN, __MAX_BYTES, __NFREELISTS */
+
+#include <atomic>               /* std::atomic<> */
+#include <mutex>                /* std::mutex, std::lock_guard<> */
+#include <cstring>              /* memcpy() */
+#include <cstddef>              /* size_t */
+
+namespace mystl
+{
+
+enum { __TC_BATCH = 32 };           /* 线程与 depot 之间一次搬运的区块数 */
+enum { __TC_DEPOT_SLOTS = 64 };     /* 每个 free-list 在 depot 中的槽位数 */
+enum { __TC_CHUNK = 16 * 1024 };    /* 线程私有内存池每次向系统申请的大小 */
+
+/* 做成模板只是为了让 static 数据成员与非 inline 的成员函数可以定义在头文件中，
+ * 被多个编译单元包含时不会重复定义。使用 thread_alloc 即可 */
+template <int inst>
+class __thread_alloc_template {
+private:
+    static size_t ROUND_UP(size_t bytes)
+        { return (bytes + __ALIGN - 1) & ~((size_t) __ALIGN - 1); }
+    static size_t FREELIST_INDEX(size_t bytes)
+        { return (bytes + __ALIGN - 1) / __ALIGN - 1; }
+
+    union obj {
+        union obj* free_list_link;
+        char client_data[1];
+    };
+
+    enum { __CACHE_FRESH = 0, __CACHE_ACTIVE, __CACHE_DEAD };
+
+    /* thread cache: 每个线程一份，只有本线程访问。
+     * 没有构造与析构函数，以 0 初始化，线程退出阶段的任何时刻都可以安全访问
+     * (其他 thread_local 对象的析构函数里仍可能配置或释放区块) */
+    struct cache {
+        obj*    free_list[__NFREELISTS];
+        size_t  count[__NFREELISTS];    /* 每个 free-list 上的区块数 */
+        char*   start_free;             /* 线程私有内存池 */
+        char*   end_free;
+        int     state;                  /* __CACHE_FRESH / __CACHE_ACTIVE / __CACHE_DEAD */
+    };
+    /* 由它的析构函数在线程结束时把 cache 交回中央。第一次使用 cache 时才构造 */
+    struct cache_guard {
+        ~cache_guard();
+    };
+
+    /* depot: 每个 free-list 有 __TC_DEPOT_SLOTS 个槽位，每个槽位存放一条区块链。
+     * 放入用 compare_exchange(0 -> chain)，取出用 exchange(0)，
+     * 取出时拿走整条链，所以不存在 ABA 问题。*/
+    static std::atomic<obj*> depot[__NFREELISTS][__TC_DEPOT_SLOTS];
+
+    /* overflow: depot 已满时的后备，每个 free-list 一条链。
+     * 大量跨线程释放时 depot 很快放满，之后的批直接挂到这里，不再反复扫描 depot */
+    struct overflow_list {
+        std::mutex          lock;
+        obj*                head;
+        std::atomic<size_t> count;      /* 区块数，不加锁即可判断是否为空 */
+    };
+    static overflow_list overflow[__NFREELISTS];
+
+    static thread_local cache tls;
+    static thread_local cache_guard guard;
+
+    /* 把以 head 开头的一条链放进 depot，depot 已满时返回 false */
+    static bool depot_push(size_t index, obj* head)
+    {
+        std::atomic<obj*>* slots = depot[index];
+        for (int i = 0; i < __TC_DEPOT_SLOTS; i++) {
+            obj* expected = 0;
+            if (slots[i].load(std::memory_order_relaxed) == 0 &&
+                    slots[i].compare_exchange_strong(expected, head,
+                        std::memory_order_release, std::memory_order_relaxed))
+                return true;
+        }
+        return false;
+    }
+    /* 从 depot 取出一条链，depot 为空时返回 0 */
+    static obj* depot_pop(size_t index)
+    {
+        std::atomic<obj*>* slots = depot[index];
+        for (int i = 0; i < __TC_DEPOT_SLOTS; i++) {
+            if (slots[i].load(std::memory_order_relaxed) != 0) {
+                obj* chain = slots[i].exchange(0, std::memory_order_acquire);
+                if (chain)
+                    return chain;
+            }
+        }
+        return 0;
+    }
+
+    /* 把 [head, tail] 这 n 个区块交回中央: 先放 depot，depot 已满时挂到 overflow */
+    static void central_push(size_t index, obj* head, obj* tail, size_t n)
+    {
+        tail->free_list_link = 0;
+        if (depot_push(index, head))
+            return;
+        overflow_list& o = overflow[index];
+        std::lock_guard<std::mutex> guard(o.lock);
+        tail->free_list_link = o.head;
+        o.head = head;
+        o.count.fetch_add(n, std::memory_order_relaxed);
+    }
+    /* 从中央取出一条以 0 结尾的链: 先取 depot，再从 overflow 取最多 __TC_BATCH 个区块 */
+    static obj* central_pop(size_t index)
+    {
+        obj* chain = depot_pop(index);
+        if (chain != 0)
+            return chain;
+        overflow_list& o = overflow[index];
+        if (o.count.load(std::memory_order_relaxed) == 0)
+            return 0;
+        std::lock_guard<std::mutex> guard(o.lock);
+        chain = o.head;
+        if (chain == 0)
+            return 0;
+        obj* tail = chain;
+        size_t n = 1;
+        for (; n < (size_t) __TC_BATCH && tail->free_list_link != 0; n++)
+            tail = tail->free_list_link;
+        o.head = tail->free_list_link;
+        tail->free_list_link = 0;
+        o.count.fetch_sub(n, std::memory_order_relaxed);
+        return chain;
+    }
+
+    static void  activate(cache& c);
+    static void* refill(cache& c, size_t n);
+    static char* chunk_alloc(cache& c, size_t size, int& nobjs);
+    static void  release_batch(cache& c, size_t index);
+
+public:
+    static void* allocate(size_t n)
+    {
+        if (n > (size_t) __MAX_BYTES)
+            return malloc_alloc::allocate(n);
+        /* FREELIST_INDEX(0) 会下溢，0 字节按最小的区块处理 */
+        if (n == 0)
+            n = 1;
+
+        cache& c = tls;
+        size_t index = FREELIST_INDEX(n);
+        obj* result = c.free_list[index];
+        if (result == 0)
+            return refill(c, ROUND_UP(n));
+        c.free_list[index] = result->free_list_link;
+        --c.count[index];
+        return result;
+    }
+
+    static void deallocate(void* p, size_t n)
+    {
+        if (n > (size_t) __MAX_BYTES) {
+            malloc_alloc::deallocate(p, n);
+            return;
+        }
+        if (n == 0)
+            n = 1;
+
+        cache& c = tls;
+        size_t index = FREELIST_INDEX(n);
+        obj* q = (obj*) p;
+        if (c.state != __CACHE_ACTIVE) {
+            if (c.state == __CACHE_DEAD) {
+                /* 线程已经进入退出阶段，区块直接交回中央 */
+                central_push(index, q, q, 1);
+                return;
+            }
+            activate(c);
+        }
+        q->free_list_link = c.free_list[index];
+        c.free_list[index] = q;
+        /* 本线程积压过多 (如跨线程释放)，交回一批给中央 */
+        if (++c.count[index] >= 2 * __TC_BATCH)
+            release_batch(c, index);
+    }
+
+    /* 更高的对齐要求交给第一级配置器 */
+    static void* allocate(size_t n, size_t align)
+    {
+        if (align <= (size_t) __ALIGN)
+            return allocate(n);
+        return malloc_alloc::allocate(n, align);
+    }
+
+    static void deallocate(void* p, size_t n, size_t align)
+    {
+        if (align <= (size_t) __ALIGN)
+            deallocate(p, n);
+        else
+            malloc_alloc::deallocate(p, n, align);
+    }
+
+    static void* reallocate(void* p, size_t old_sz, size_t new_sz)
+    {
+        if (old_sz > (size_t) __MAX_BYTES && new_sz > (size_t) __MAX_BYTES)
+            return malloc_alloc::reallocate(p, old_sz, new_sz);
+        if (ROUND_UP(old_sz) == ROUND_UP(new_sz))
+            return p;
+
+        void* result = allocate(new_sz);
+        memcpy(result, p, new_sz > old_sz ? old_sz : new_sz);
+        deallocate(p, old_sz);
+        return result;
+    }
+};
+
+/* __thread_alloc_template static data member */
+template <int inst>
+std::atomic<typename __thread_alloc_template<inst>::obj*>
+__thread_alloc_template<inst>::depot[__NFREELISTS][__TC_DEPOT_SLOTS];
+template <int inst>
+typename __thread_alloc_template<inst>::overflow_list
+__thread_alloc_template<inst>::overflow[__NFREELISTS];
+template <int inst>
+thread_local typename __thread_alloc_template<inst>::cache __thread_alloc_template<inst>::tls;
+template <int inst>
+thread_local typename __thread_alloc_template<inst>::cache_guard __thread_alloc_template<inst>::guard;
+
+/* 本线程第一次使用 cache: 构造 guard，使线程结束时会执行它的析构函数 */
+template <int inst>
+void __thread_alloc_template<inst>::activate(cache& c)
+{
+    cache_guard* volatile g = &guard;
+    (void) g;
+    c.state = __CACHE_ACTIVE;
+}
+
+/* 线程结束: 把所有 free-list 整条交回中央，供其他线程继续使用。
+ * 此后 tls 仍然可用，配置与释放都直接经过中央 */
+template <int inst>
+__thread_alloc_template<inst>::cache_guard::~cache_guard()
+{
+    cache& c = tls;
+    c.state = __CACHE_DEAD;
+    for (int i = 0; i < __NFREELISTS; i++) {
+        if (c.free_list[i] == 0)
+            continue;
+        obj* tail = c.free_list[i];
+        size_t n = 1;
+        for (; tail->free_list_link != 0; n++)
+            tail = tail->free_list_link;
+        central_push(i, c.free_list[i], tail, n);
+        c.free_list[i] = 0;
+        c.count[i] = 0;
+    }
+}
+
+/* 从 free-list 头部摘下 __TC_BATCH 个区块交回中央 */
+template <int inst>
+void __thread_alloc_template<inst>::release_batch(cache& c, size_t index)
+{
+    obj* head = c.free_list[index];
+    obj* tail = head;
+    for (int i = 1; i < __TC_BATCH; i++)
+        tail = tail->free_list_link;
+    c.free_list[index] = tail->free_list_link;
+    c.count[index] -= __TC_BATCH;
+    central_push(index, head, tail, __TC_BATCH);
+}
+
+/* n 已经上调至 __ALIGN 的倍数
+ * 先从中央取一条链，中央没有时再从线程私有内存池切出 __TC_BATCH 个区块 */
+template <int inst>
+void* __thread_alloc_template<inst>::refill(cache& c, size_t n)
+{
+    if (c.state != __CACHE_ACTIVE) {
+        /* 线程已经进入退出阶段，不再往 cache 里放区块 */
+        if (c.state == __CACHE_DEAD)
+            return malloc_alloc::allocate(n);
+        activate(c);
+    }
+    size_t index = FREELIST_INDEX(n);
+
+    obj* chain = central_pop(index);
+    if (chain != 0) {
+        size_t cnt = 0;
+        for (obj* p = chain->free_list_link; p != 0; p = p->free_list_link)
+            ++cnt;
+        c.free_list[index] = chain->free_list_link;
+        c.count[index] = cnt;
+        return chain;
+    }
+
+    int nobjs = __TC_BATCH;
+    char* chunk = chunk_alloc(c, n, nobjs);
+    if (nobjs == 1)
+        return chunk;
+
+    obj* result = (obj*) chunk;
+    obj* next_obj = (obj*) (chunk + n);
+    c.free_list[index] = next_obj;
+    c.count[index] = nobjs - 1;
+    for (int i = 1; ; i++) {
+        obj* current_obj = next_obj;
+        next_obj = (obj*) ((char*) next_obj + n);
+        if (nobjs - 1 == i) {
+            current_obj->free_list_link = 0;
+            break;
+        }
+        current_obj->free_list_link = next_obj;
+    }
+    return result;
+}
+
+/* 与 default_alloc::chunk_alloc() 相同，只是内存池属于本线程，无需同步 */
+template <int inst>
+char* __thread_alloc_template<inst>::chunk_alloc(cache& c, size_t size, int& nobjs)
+{
+    char* result;
+    size_t total_bytes = size * nobjs;
+    size_t bytes_left = c.end_free - c.start_free;
+
+    if (bytes_left >= size) {
+        if (bytes_left < total_bytes)
+            nobjs = (int) (bytes_left / size);
+        result = c.start_free;
+        c.start_free += size * nobjs;
+        return result;
+    }
+
+    /* 残余零头配给适当的 free-list */
+    if (bytes_left > 0) {
+        size_t index = FREELIST_INDEX(bytes_left);
+        ((obj*) c.start_free)->free_list_link = c.free_list[index];
+        c.free_list[index] = (obj*) c.start_free;
+        ++c.count[index];
+    }
+
+    size_t bytes_to_get = total_bytes > (size_t) __TC_CHUNK ? total_bytes : (size_t) __TC_CHUNK;
+    c.start_free = (char*) malloc_alloc::allocate(bytes_to_get);
+    c.end_free = c.start_free + bytes_to_get;
+    return chunk_alloc(c, size, nobjs);
+}
+
+typedef     __thread_alloc_template<0>      thread_alloc;
+
+}
+
+#endif
@@ -16,8 +16,13 @@ namespace mystl
 struct __true_type { };
 struct __false_type { };
 
+/* 把编译期的 bool 转为 __true_type / __false_type，以便重载分派 */
+template <bool>
+struct __bool_type { typedef __false_type type; };
+__STL_TEMPLATE_NULL struct __bool_type<true> { typedef __true_type type; };
+
 template <typename type>
-class __type_traits {
+struct __type_traits {
     typedef __true_type     this_dummy_member_must_be_first;
 
     /* 做出保守的估值 __false_type，
@@ -27,6 +32,9 @@ class __type_traits {
     typedef __false_type    has_trivial_assignment_operator;
     typedef __false_type    has_trivial_destructor;
     typedef __false_type    is_POD_type;
+    /* 可以逐字节搬移: 以 memcpy() 搬到新位置之后，原位置不需要析构。
+     * 例如只持有独占指针的型别。为自己的型别特化 __type_traits 即可加入 */
+    typedef __false_type    is_trivially_relocatable;
 };
 
 /* 特化版本 */
@@ -43,6 +51,7 @@ __STL_TEMPLATE_NULL struct __type_traits<char> {
     typedef __true_type    has_trivial_assignment_operator;
     typedef __true_type    has_trivial_destructor;
     typedef __true_type    is_POD_type;
+    typedef __true_type    is_trivially_relocatable;
 };
 
 __STL_TEMPLATE_NULL struct __type_traits<signed char> {
@@ -51,6 +60,7 @@ __STL_TEMPLATE_NULL struct __type_traits<signed char> {
     typedef __true_type    has_trivial_assignment_operator;
     typedef __true_type    has_trivial_destructor;
     typedef __true_type    is_POD_type;
+    typedef __true_type    is_trivially_relocatable;
 };
 
 __STL_TEMPLATE_NULL struct __type_traits<unsigned char> {
@@ -59,6 +69,7 @@ __STL_TEMPLATE_NULL struct __type_traits<unsigned char> {
     typedef __true_type    has_trivial_assignment_operator;
     typedef __true_type    has_trivial_destructor;
     typedef __true_type    is_POD_type;
+    typedef __true_type    is_trivially_relocatable;
 };
 
 __STL_TEMPLATE_NULL struct __type_traits<short> {
@@ -67,6 +78,7 @@ __STL_TEMPLATE_NULL struct __type_traits<short> {
     typedef __true_type    has_trivial_assignment_operator;
     typedef __true_type    has_trivial_destructor;
     typedef __true_type    is_POD_type;
+    typedef __true_type    is_trivially_relocatable;
 };
 
 __STL_TEMPLATE_NULL struct __type_traits<unsigned short> {
@@ -75,6 +87,7 @@ __STL_TEMPLATE_NULL struct __type_traits<unsigned short> {
     typedef __true_type    has_trivial_assignment_operator;
     typedef __true_type    has_trivial_destructor;
     typedef __true_type    is_POD_type;
+    typedef __true_type    is_trivially_relocatable;
 };
 
 __STL_TEMPLATE_NULL struct __type_traits<int> {
@@ -83,6 +96,7 @@ __STL_TEMPLATE_NULL struct __type_traits<int> {
     typedef __true_type    has_trivial_assignment_operator;
     typedef __true_type    has_trivial_destructor;
     typedef __true_type    is_POD_type;
+    typedef __true_type    is_trivially_relocatable;
 };
 
 __STL_TEMPLATE_NULL struct __type_traits<unsigned int> {
@@ -91,6 +105,7 @@ __STL_TEMPLATE_NULL struct __type_traits<unsigned int> {
     typedef __true_type    has_trivial_assignment_operator;
     typedef __true_type    has_trivial_destructor;
     typedef __true_type    is_POD_type;
+    typedef __true_type    is_trivially_relocatable;
 };
 
 __STL_TEMPLATE_NULL struct __type_traits<long> {
@@ -99,6 +114,7 @@ __STL_TEMPLATE_NULL struct __type_traits<long> {
     typedef __true_type    has_trivial_assignment_operator;
     typedef __true_type    has_trivial_destructor;
     typedef __true_type    is_POD_type;
+    typedef __true_type    is_trivially_relocatable;
 };
 
 __STL_TEMPLATE_NULL struct __type_traits<unsigned long> {
@@ -107,6 +123,7 @@ __STL_TEMPLATE_NULL struct __type_traits<unsigned long> {
     typedef __true_type    has_trivial_assignment_operator;
     typedef __true_type    has_trivial_destructor;
     typedef __true_type    is_POD_type;
+    typedef __true_type    is_trivially_relocatable;
 };
 
 __STL_TEMPLATE_NULL struct __type_traits<float> {
@@ -115,6 +132,7 @@ __STL_TEMPLATE_NULL struct __type_traits<float> {
     typedef __true_type    has_trivial_assignment_operator;
     typedef __true_type    has_trivial_destructor;
     typedef __true_type    is_POD_type;
+    typedef __true_type    is_trivially_relocatable;
 };
 
 __STL_TEMPLATE_NULL struct __type_traits<double> {
@@ -123,6 +141,7 @@ __STL_TEMPLATE_NULL struct __type_traits<double> {
     typedef __true_type    has_trivial_assignment_operator;
     typedef __true_type    has_trivial_destructor;
     typedef __true_type    is_POD_type;
+    typedef __true_type    is_trivially_relocatable;
 };
 
 __STL_TEMPLATE_NULL struct __type_traits<long double> {
@@ -131,6 +150,7 @@ __STL_TEMPLATE_NULL struct __type_traits<long double> {
     typedef __true_type    has_trivial_assignment_operator;
     typedef __true_type    has_trivial_destructor;
     typedef __true_type    is_POD_type;
+    typedef __true_type    is_trivially_relocatable;
 };
 
 /* for 原生指针 */
@@ -141,6 +161,7 @@ struct __type_traits<T*> {
     typedef __true_type    has_trivial_assignment_operator;
     typedef __true_type    has_trivial_destructor;
     typedef __true_type    is_POD_type;
+    typedef __true_type    is_trivially_relocatable;
 };
 
 }
@@ -3,7 +3,8 @@
  * date		: 2019年 08月 05日 星期一 12:04:03 CST
  * last update	: 
  * 
- * description	: uninitialized_copy(), uninitialized_fill(), uninitialized_fill_n()
+ * description	: uninitialized_copy(), uninitialized_move(), uninitialized_move_if_noexcept(),
+ *      uninitialized_fill(), uninitialized_fill_n(), uninitialized_default_n()
  * 与 construct(), destroy() 一样，作用于已经申请而没有初始化的空间上。
  */
 
@@ -11,11 +12,13 @@
 #define     _MYSTL_UNINITIALIZED_
 
 #include "mystl_type_traits.hpp"    /* __true_type{}, __false_type __type_traits<>{} */
-#include "mystl_iterator.hpp"       /* value_type() */
+#include "mystl_iterator.hpp"       /* value_type(), advance() */
 #include "mystl_construct.hpp"      /* construct() */
 #include "mystl_algobase.hpp"       /* copy(), fill(), fill_n() */
 
 #include <cstring>          /* memmove() */
+#include <utility>          /* std::move() */
+#include <type_traits>      /* std::is_nothrow_move_constructible<> */
 
 namespace mystl
 {
@@ -48,7 +51,7 @@ inline ForwardIterator
 __uninitialized_copy_aux(InputIterator first, InputIterator last, 
         ForwardIterator result, __true_type)
 {
-    return copy(first, last, result);   /* mystl::copy() 算法 */ 
+    return mystl::copy(first, last, result);   /* mystl::copy() 算法 */ 
 }
 
 template <typename InputIterator, typename ForwardIterator>
@@ -57,8 +60,14 @@ __uninitialized_copy_aux(InputIterator first, InputIterator last,
         ForwardIterator result, __false_type)
 {
     ForwardIterator cur = result;
-    for (; first != last; ++first, ++cur)
-        construct(&*cur, *first);       /* mystl_construct.hpp::construct() */
+    try {
+        for (; first != last; ++first, ++cur)
+            mystl::construct(&*cur, *first);   /* mystl_construct.hpp::construct() */
+    } catch (...) {
+        /* commit or rollback: 析构已经构造的元素 */
+        mystl::destroy(result, cur);
+        throw;
+    }
     return cur;         /* return 'last' of initialized space */
 }
 
@@ -76,6 +85,79 @@ inline wchar_t* uninitialized_copy(const wchar_t* first,
 }
 
 
+/* (1.1) uninitialized_move()
+ * 与 uninitialized_copy() 相同，但以移动构造代替复制构造 */
+template <typename InputIterator, typename ForwardIterator, typename T>
+inline ForwardIterator
+__uninitialized_move(InputIterator first, InputIterator last,
+        ForwardIterator result, T*)
+{
+    typedef typename __type_traits<T>::is_POD_type is_POD;
+    return __uninitialized_move_aux(first, last, result, is_POD());
+}
+
+template <typename InputIterator, typename ForwardIterator>
+inline ForwardIterator
+uninitialized_move(InputIterator first, InputIterator last, ForwardIterator result)
+{
+    return __uninitialized_move(first, last, result, value_type(result));
+}
+
+template <typename InputIterator, typename ForwardIterator>
+inline ForwardIterator
+__uninitialized_move_aux(InputIterator first, InputIterator last,
+        ForwardIterator result, __true_type)
+{
+    return mystl::copy(first, last, result);   /* POD 型别，移动即复制 */
+}
+
+template <typename InputIterator, typename ForwardIterator>
+inline ForwardIterator
+__uninitialized_move_aux(InputIterator first, InputIterator last,
+        ForwardIterator result, __false_type)
+{
+    ForwardIterator cur = result;
+    try {
+        for (; first != last; ++first, ++cur)
+            mystl::construct(&*cur, std::move(*first));
+    } catch (...) {
+        mystl::destroy(result, cur);
+        throw;
+    }
+    return cur;
+}
+
+/* (1.2) uninitialized_move_if_noexcept()
+ * 移动构造不会抛出异常 (或者型别不能复制) 时移动，否则复制。
+ * 供容器重新配置空间时搬移元素: 搬移过程中发生异常，原空间的元素保持不变 */
+template <typename InputIterator, typename ForwardIterator>
+inline ForwardIterator
+uninitialized_move_if_noexcept(InputIterator first, InputIterator last,
+        ForwardIterator result)
+{
+    typedef typename iterator_traits<ForwardIterator>::value_type T;
+    typedef typename __bool_type<std::is_nothrow_move_constructible<T>::value ||
+        !std::is_copy_constructible<T>::value>::type use_move;
+    return __uninitialized_move_if_noexcept(first, last, result, use_move());
+}
+
+template <typename InputIterator, typename ForwardIterator>
+inline ForwardIterator
+__uninitialized_move_if_noexcept(InputIterator first, InputIterator last,
+        ForwardIterator result, __true_type)
+{
+    return mystl::uninitialized_move(first, last, result);
+}
+
+template <typename InputIterator, typename ForwardIterator>
+inline ForwardIterator
+__uninitialized_move_if_noexcept(InputIterator first, InputIterator last,
+        ForwardIterator result, __false_type)
+{
+    return mystl::uninitialized_copy(first, last, result);
+}
+
+
 /* (2) uninitialized_fill() 
  * first 指向输出端（欲初始化空间的）起始处 
  * last  指向输出端（欲初始化空间的）结束处（前闭后开区间）
@@ -101,7 +183,7 @@ template <typename ForwardIterator, typename T>
 inline void __uninitialized_fill_aux(ForwardIterator first, ForwardIterator last, 
         const T& x, __true_type)
 {
-    fill(first, last, x);       /* mystl 算法 fill */
+    mystl::fill(first, last, x);       /* mystl 算法 fill */
 }
 
 template <typename ForwardIterator, typename T>
@@ -109,9 +191,13 @@ inline void __uninitialized_fill_aux(ForwardIterator first, ForwardIterator last
         const T& x, __false_type)
 {
     ForwardIterator cur = first;
-    //! 异常处理
-    for (; cur != last; ++cur)
-        construct(&*cur, x);
+    try {
+        for (; cur != last; ++cur)
+            mystl::construct(&*cur, x);
+    } catch (...) {
+        mystl::destroy(first, cur);
+        throw;
+    }
 }
 
 
@@ -141,7 +227,7 @@ template <typename ForwardIterator, typename Size, typename T>
 inline ForwardIterator
 __uninitialized_fill_n_aux(ForwardIterator first, Size n, const T& x, __true_type)
 {
-    return fill_n(first, n, x);
+    return mystl::fill_n(first, n, x);
 }
 
 template <typename ForwardIterator, typename Size, typename T>
@@ -149,8 +235,55 @@ inline ForwardIterator
 __uninitialized_fill_n_aux(ForwardIterator first, Size n, const T& x, __false_type)
 {
     ForwardIterator cur = first;
-    for (; n > 0; n--, ++cur)
-        construct(&*cur, x);
+    try {
+        for (; n > 0; n--, ++cur)
+            mystl::construct(&*cur, x);
+    } catch (...) {
+        mystl::destroy(first, cur);
+        throw;
+    }
+    return cur;
+}
+
+
+/* (4) uninitialized_default_n()
+ * 在 [first, first + n) 上以缺省构造函数构造元素。
+ * 缺省构造函数为 trivial 的型别什么也不做，空间保持未初始化的内容 */
+template <typename ForwardIterator, typename Size, typename T>
+inline ForwardIterator
+__uninitialized_default_n(ForwardIterator first, Size n, T*)
+{
+    typedef typename __type_traits<T>::has_trivial_default_constructor trivial;
+    return __uninitialized_default_n_aux(first, n, trivial());
+}
+
+template <typename ForwardIterator, typename Size>
+inline ForwardIterator
+uninitialized_default_n(ForwardIterator first, Size n)
+{
+    return __uninitialized_default_n(first, n, value_type(first));
+}
+
+template <typename ForwardIterator, typename Size>
+inline ForwardIterator
+__uninitialized_default_n_aux(ForwardIterator first, Size n, __true_type)
+{
+    mystl::advance(first, n);
+    return first;
+}
+
+template <typename ForwardIterator, typename Size>
+inline ForwardIterator
+__uninitialized_default_n_aux(ForwardIterator first, Size n, __false_type)
+{
+    ForwardIterator cur = first;
+    try {
+        for (; n > 0; n--, ++cur)
+            mystl::construct(&*cur);
+    } catch (...) {
+        mystl::destroy(first, cur);
+        throw;
+    }
     return cur;
 }
 
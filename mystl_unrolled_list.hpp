@@ -0,0 +1,413 @@
+/* file		: mystl_unrolled_list.hpp
+ * by		: waterlemon	429426523@qq.com
+ * date		: Sun 18 Oct 2026 05:02:17 PM CST
+ * last update	:
+ *
+ * description	: unrolled_list
+ * unrolled_list 是结点内存放一小段连续元素的双向链表。
+ * list 每个元素一个结点，遍历时每一步都要跟随一个指针到不相邻的内存；
+ * unrolled_list 每个结点存放最多 node_capacity 个元素，遍历时大部分步骤只是在结点内移动，
+ * 与 vector 一样逐个读取连续的内存。
+ * 在中间插入或删除只搬移同一个结点内的元素 (最多 node_capacity 个)，不影响其他结点:
+ *      unrolled_list<int> l;
+ *      l.insert(it, 1);            // 结点已满时对半分裂
+ *
+ * 插入与删除会使同一个结点 (分裂或合并时还有相邻结点) 内元素的迭代器失效。
+ */
+
+#ifndef     _MYSTL_UNROLLED_LIST_
+#define     _MYSTL_UNROLLED_LIST_
+
+#include "mystl_alloc.hpp"      /* simple_alloc{}, alloc{}, __alloc_holder{} */
+#include "mystl_iterator.hpp"   /* bidirectional_iterator_tag{} */
+#include "mystl_construct.hpp"  /* construct(), destroy() */
+#include "mystl_algobase.hpp"   /* move(), move_backward() */
+#include "mystl_uninitialized.hpp"  /* uninitialized_move() */
+
+#include <cstddef>              /* size_t, ptrdiff_t */
+#include <utility>              /* std::move(), std::forward(), std::swap() */
+#include <type_traits>          /* std::aligned_storage<> */
+
+namespace mystl
+{
+
+enum { __UNROLLED_NODE_BYTES = 256 };   /* 每个结点存放元素的空间 */
+
+/* 结点的链接部分。头结点只有这一部分，count 为 0 */
+struct __unrolled_node_base {
+    __unrolled_node_base*   prev;
+    __unrolled_node_base*   next;
+    size_t                  count;      /* 结点内的元素个数 */
+};
+
+/* 元素不大于 __UNROLLED_NODE_BYTES / 4 时填满这块空间，否则每个结点放 4 个，
+ * 保证分裂后的两个结点都还有空位 */
+template <typename T>
+struct __unrolled_node : public __unrolled_node_base {
+    enum { capacity = sizeof (T) * 4 <= (size_t) __UNROLLED_NODE_BYTES ?
+        (size_t) __UNROLLED_NODE_BYTES / sizeof (T) : 4 };
+
+    typename std::aligned_storage<sizeof (T) * capacity, alignof(T)>::type buf;
+
+    T* elems() { return (T*) &buf; }
+};
+
+/* unrolled_list迭代器: __unrolled_iterator
+ * 记住所在的结点与结点内的下标；走出结点的最后一个元素时跳到下一个结点 */
+template <typename T, typename Ref, typename Ptr>
+struct __unrolled_iterator {
+    typedef __unrolled_iterator<T, T&, T*>  iterator;
+    typedef __unrolled_iterator<T, Ref, Ptr> self;
+
+    typedef bidirectional_iterator_tag      iterator_category;
+    typedef T                               value_type;
+    typedef Ptr                             pointer;
+    typedef Ref                             reference;
+    typedef ptrdiff_t                       difference_type;
+    typedef size_t                          size_type;
+
+    typedef __unrolled_node_base*           base_ptr;
+    typedef __unrolled_node<T>*             link_type;
+
+    base_ptr    node;       /* 所在结点，end() 为头结点 */
+    size_type   index;      /* 结点内的下标 */
+
+    __unrolled_iterator() : node(0), index(0) {}
+    __unrolled_iterator(base_ptr x, size_type i) : node(x), index(i) {}
+    __unrolled_iterator(const iterator& x) : node(x.node), index(x.index) {}
+
+    bool operator== (const self& x) const { return node == x.node && index == x.index; }
+    bool operator!= (const self& x) const { return !(*this == x); }
+
+    reference operator* () const { return ((link_type) node)->elems()[index]; }
+    pointer operator-> () const { return &(operator*()); }
+
+    self& operator++ ()
+    {
+        if (++index == node->count) {
+            node = node->next;
+            index = 0;
+        }
+        return *this;
+    }
+    self operator++ (int)
+    {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+    self& operator-- ()
+    {
+        if (index == 0) {
+            node = node->prev;
+            index = node->count;
+        }
+        --index;
+        return *this;
+    }
+    self operator-- (int)
+    {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+};
+
+/* unrolled_list 与 list 一样是环形链表，头结点放在对象内部，不另外配置 */
+template <typename T, typename Alloc = alloc>
+class unrolled_list : protected __alloc_holder<Alloc> {
+public:
+    typedef T                               value_type;
+    typedef T*                              pointer;
+    typedef T&                              reference;
+    typedef const T&                        const_reference;
+    typedef ptrdiff_t                       difference_type;
+    typedef size_t                          size_type;
+    typedef __unrolled_iterator<T, T&, T*>  iterator;
+    typedef Alloc                           allocator_type;
+
+protected:
+    typedef __alloc_holder<Alloc>           alloc_base;
+    typedef __unrolled_node_base            node_base;
+    typedef node_base*                      base_ptr;
+    typedef __unrolled_node<T>              unrolled_node;
+    typedef unrolled_node*                  link_type;
+    typedef simple_alloc<unrolled_node, Alloc> node_allocator;
+
+public:
+    enum { node_capacity = unrolled_node::capacity };
+
+protected:
+    node_base   head;
+    size_type   length;     /* 元素个数 */
+
+    /* 配置一个空结点，接在 prev 之后 */
+    link_type create_node(base_ptr prev)
+    {
+        link_type p = node_allocator::allocate(this->allocator());
+        p->count = 0;
+        p->prev = prev;
+        p->next = prev->next;
+        prev->next->prev = p;
+        prev->next = p;
+        return p;
+    }
+    /* p 内的元素已经析构或移走 */
+    void destroy_node(base_ptr p)
+    {
+        p->prev->next = p->next;
+        p->next->prev = p->prev;
+        node_allocator::deallocate(this->allocator(), (link_type) p);
+    }
+
+    void empty_initialize()
+    {
+        head.prev = head.next = &head;
+        head.count = 0;
+        length = 0;
+    }
+    /* 复制或交换 head 之后，让首尾结点指回本对象的 head */
+    void relink_head()
+    {
+        if (length == 0)
+            empty_initialize();
+        else {
+            head.next->prev = &head;
+            head.prev->next = &head;
+        }
+    }
+
+public:
+    iterator begin() { return iterator(head.next, 0); }
+    iterator end() { return iterator(&head, 0); }
+    size_type size() { return length; }
+    bool empty() { return length == 0; }
+    reference front() { return *begin(); }
+    reference back() { return *(--end()); }
+
+    using alloc_base::get_allocator;
+
+public:
+    unrolled_list() { empty_initialize(); }
+    explicit unrolled_list(const Alloc& a) : alloc_base(a) { empty_initialize(); }
+    unrolled_list(size_type n, const T& value, const Alloc& a = Alloc()) : alloc_base(a)
+    {
+        empty_initialize();
+        try {
+            while (n--)
+                push_back(value);
+        } catch (...) {
+            clear();
+            throw;
+        }
+    }
+    unrolled_list(const unrolled_list& x) : alloc_base(x.get_allocator())
+    {
+        empty_initialize();
+        try {
+            append(x);
+        } catch (...) {
+            clear();
+            throw;
+        }
+    }
+    /* 移动构造: 接管 x 的所有结点 */
+    unrolled_list(unrolled_list&& x) : alloc_base(x.get_allocator())
+    {
+        empty_initialize();
+        swap(x);
+    }
+    unrolled_list& operator= (const unrolled_list& x)
+    {
+        if (this != &x) {
+            clear();
+            append(x);
+        }
+        return *this;
+    }
+    unrolled_list& operator= (unrolled_list&& x)
+    {
+        if (this != &x) {
+            clear();
+            swap(x);
+        }
+        return *this;
+    }
+    ~unrolled_list() { clear(); }
+
+    /* 交换两个 unrolled_list 的结点与配置器，不复制任何元素 */
+    void swap(unrolled_list& x) noexcept
+    {
+        std::swap(this->allocator(), x.allocator());
+        std::swap(head, x.head);
+        std::swap(length, x.length);
+        relink_head();
+        x.relink_head();
+    }
+
+protected:
+    /* 把 x 的元素依次接在尾端，新结点都是填满的 */
+    void append(const unrolled_list& x)
+    {
+        for (base_ptr p = x.head.next; p != &x.head; p = p->next) {
+            T* e = ((link_type) p)->elems();
+            for (size_type i = 0; i < p->count; i++)
+                push_back(e[i]);
+        }
+    }
+
+    /* p 未满: 在 p 的下标 i 处放入 x */
+    void insert_in_node(link_type p, size_type i, T&& x)
+    {
+        T* e = p->elems();
+        const size_type n = p->count;
+        if (i == n)
+            mystl::construct(e + n, std::move(x));
+        else {
+            mystl::construct(e + n, std::move(e[n-1]));
+            mystl::move_backward(e + i, e + n - 1, e + n);
+            e[i] = std::move(x);
+        }
+        ++p->count;
+    }
+
+    /* p 已满: 后一半元素移到新的结点，返回新结点 */
+    link_type split_node(link_type p)
+    {
+        link_type q = create_node(p);
+        const size_type half = p->count / 2;
+        T* e = p->elems();
+        try {
+            mystl::uninitialized_move(e + half, e + p->count, q->elems());
+        } catch (...) {
+            destroy_node(q);
+            throw;
+        }
+        mystl::destroy(e + half, e + p->count);
+        q->count = p->count - half;
+        p->count = half;
+        return q;
+    }
+
+    /* 删除之后，p 与下一个结点合起来不超过 3/4 时把下一个结点并入 p，
+     * 避免反复删除之后留下许多几乎是空的结点 */
+    void merge_next(link_type p)
+    {
+        base_ptr next = p->next;
+        if (next == &head || p->count + next->count > (size_type) node_capacity * 3 / 4)
+            return;
+        T* e = ((link_type) next)->elems();
+        mystl::uninitialized_move(e, e + next->count, p->elems() + p->count);
+        mystl::destroy(e, e + next->count);
+        p->count += next->count;
+        destroy_node(next);
+    }
+
+public:
+    void push_back(const T& x) { emplace_back(x); }
+    void push_back(T&& x) { emplace_back(std::move(x)); }
+    void push_front(const T& x) { emplace(begin(), x); }
+    void push_front(T&& x) { emplace(begin(), std::move(x)); }
+
+    /* 最后一个结点还有空位时直接在那里构造，这是最常见的情形 */
+    template <typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        base_ptr last = head.prev;
+        if (last != &head && last->count < (size_type) node_capacity) {
+            mystl::construct(((link_type) last)->elems() + last->count,
+                    std::forward<Args>(args)...);
+            ++last->count;
+            ++length;
+        }
+        else
+            emplace(end(), std::forward<Args>(args)...);
+    }
+
+    iterator insert(iterator position, const T& x) { return emplace(position, x); }
+    iterator insert(iterator position, T&& x) { return emplace(position, std::move(x)); }
+
+    /* 在 position 之前插入。position 所在结点已满时:
+     * 插在结点开头且前一个结点有空位，就放到前一个结点的末尾；
+     * 否则插在开头时在前面接一个新结点，插在中间时把结点对半分裂 */
+    template <typename... Args>
+    iterator emplace(iterator position, Args&&... args)
+    {
+        T x_copy(std::forward<Args>(args)...);  /* args 可能引用本容器中的元素 */
+        base_ptr p = position.node;
+        size_type i = position.index;
+        if (p == &head || (i == 0 && p->count == (size_type) node_capacity)) {
+            p = p->prev;
+            if (p == &head || p->count == (size_type) node_capacity)
+                p = create_node(p);
+            i = p->count;
+        }
+        else if (p->count == (size_type) node_capacity) {
+            link_type q = split_node((link_type) p);
+            if (i > p->count) {
+                i -= p->count;
+                p = q;
+            }
+        }
+        try {
+            insert_in_node((link_type) p, i, std::move(x_copy));
+        } catch (...) {
+            if (p->count == 0)
+                destroy_node(p);
+            throw;
+        }
+        ++length;
+        return iterator(p, i);
+    }
+
+    iterator erase(iterator position)
+    {
+        link_type p = (link_type) position.node;
+        const size_type i = position.index;
+        T* e = p->elems();
+        mystl::move(e + i + 1, e + p->count, e + i);
+        mystl::destroy(e + p->count - 1);
+        --p->count;
+        --length;
+        if (p->count == 0) {
+            base_ptr next = p->next;
+            destroy_node(p);
+            return iterator(next, 0);
+        }
+        merge_next(p);
+        return i < p->count ? iterator(p, i) : iterator(p->next, 0);
+    }
+    iterator erase(iterator first, iterator last)
+    {
+        /* 每次删除都可能使 last 失效，所以先数出要删除的个数 */
+        size_type n = mystl::distance(first, last);
+        while (n--)
+            first = erase(first);
+        return first;
+    }
+    void pop_front() { erase(begin()); }
+    void pop_back() { erase(--end()); }
+
+    void clear()
+    {
+        base_ptr p = head.next;
+        while (p != &head) {
+            base_ptr next = p->next;
+            T* e = ((link_type) p)->elems();
+            mystl::destroy(e, e + p->count);
+            node_allocator::deallocate(this->allocator(), (link_type) p);
+            p = next;
+        }
+        empty_initialize();
+    }
+};
+
+template <typename T, typename Alloc>
+inline void swap(unrolled_list<T, Alloc>& x, unrolled_list<T, Alloc>& y) noexcept
+{
+    x.swap(y);
+}
+
+}
+
+#endif
@@ -4,27 +4,89 @@
  * last update	: 
  * 
  * description	: vector
+ * 第三个模板参数 Growth 是扩充空间的策略:
+ *      growth_x2           每次扩充为 2 倍 (缺省)
+ *      growth_x1_5         每次扩充为 1.5 倍，内存占用较少，扩充次数较多
+ *      growth_size_class   1.5 倍后上调至配置器的区块大小，不浪费配置器补齐的空间
+ * 需要时以 reserve() 预先配置空间，以 shrink_to_fit() 归还多余的空间。
+ *
+ * resize_default_init() 与 append_uninitialized() 不为缺省构造函数 trivial 的型别
+ * 初始化新元素，用作 I/O 缓冲区时不必先清零再由 read() 覆盖:
+ *      ssize_t r = read(fd, buf.append_uninitialized(n), n);
+ *      buf.resize(buf.size() - n + (r > 0 ? r : 0));
  */
 
 #ifndef     _MYSTL_VECTOR_
 #define     _MYSTL_VECTOR_
 
-#include "mystl_alloc.hpp"      /* simple_alloc{}, alloc{} */
+#include "mystl_alloc.hpp"      /* simple_alloc{}, alloc{}, __alloc_holder{}, __ALIGN, __MAX_BYTES */
+#include "mystl_iterator.hpp"   /* iterator_category(), distance(), advance() */
 #include "mystl_construct.hpp"  /* destroy(), construct() */
-#include "mystl_algobase.hpp"   /* copy(), copy_backward(), fill(), max() */
-#include "mystl_uninitialized.hpp"  /* uninitialized_fill_n(), uninitialized_copy() */
+#include "mystl_algobase.hpp"   /* copy(), move(), move_backward(), fill() */
+#include "mystl_uninitialized.hpp"  /* uninitialized_copy(), uninitialized_fill_n(),
+                                       uninitialized_default_n(), uninitialized_move(),
+                                       uninitialized_move_if_noexcept() */
 
 #include <cstddef>              /* size_t, ptrdiff_t */
+#include <cstring>              /* memmove(), memcpy() */
+#include <utility>              /* std::move(), std::forward(), std::swap() */
+#include <type_traits>          /* std::aligned_storage<>, std::is_integral<> */
 
 namespace mystl
 {
-template <typename T, typename Alloc = alloc>
-class vector {
+
+/* 扩充策略: next_capacity() 返回新的容量 (元素个数)，不小于 required。
+ * cap 为目前的容量，elem_size 为每个元素的字节数 */
+struct growth_x2 {
+    static size_t next_capacity(size_t cap, size_t required, size_t /* elem_size */)
+    {
+        size_t n = cap != 0 ? 2 * cap : 1;
+        return n > required ? n : required;
+    }
+};
+
+struct growth_x1_5 {
+    static size_t next_capacity(size_t cap, size_t required, size_t /* elem_size */)
+    {
+        size_t n = cap + cap / 2;
+        if (n < cap + 1)
+            n = cap + 1;
+        return n > required ? n : required;
+    }
+};
+
+/* 小区块上调至 __ALIGN 的倍数 (default_alloc 的 free-list)，
+ * 不超过一页时上调至 2 的幂次，更大的区块上调至整页 */
+struct growth_size_class {
+    enum { __PAGE_SIZE = 4096 };
+
+    static size_t round_bytes(size_t bytes)
+    {
+        if (bytes <= (size_t) __MAX_BYTES)
+            return (bytes + __ALIGN - 1) & ~((size_t) __ALIGN - 1);
+        if (bytes <= (size_t) __PAGE_SIZE) {
+            size_t n = __MAX_BYTES;
+            while (n < bytes)
+                n <<= 1;
+            return n;
+        }
+        return (bytes + __PAGE_SIZE - 1) & ~((size_t) __PAGE_SIZE - 1);
+    }
+    static size_t next_capacity(size_t cap, size_t required, size_t elem_size)
+    {
+        size_t n = growth_x1_5::next_capacity(cap, required, elem_size);
+        return round_bytes(n * elem_size) / elem_size;
+    }
+};
+
+template <typename T, typename Alloc = alloc, typename Growth = growth_x2>
+class vector : protected __alloc_holder<Alloc> {
 public:
     /* 以下定义仅仅用于本 class，与iterator_traits没有关系。*/
     typedef T                               value_type;
     typedef T*                              pointer;
     typedef T&                              reference;
+    typedef const T&                        const_reference;
     typedef ptrdiff_t                       difference_type;
 
     typedef size_t          size_type;
@@ -36,23 +98,80 @@ public:
      * operator+=, operator-= 这些操作普通指针天生具备 
      * 所以 vector 的迭代器是 RandomAccessIterator */
 
+    typedef Alloc           allocator_type;
+    typedef Growth          growth_policy;
+
 protected:
+    typedef __alloc_holder<Alloc>           alloc_base;
     typedef simple_alloc<value_type, Alloc> data_allocator;
+    /* 可以逐字节搬移的型别，搬移元素时以 memmove() 代替移动构造与析构 */
+    typedef typename __type_traits<T>::is_trivially_relocatable relocatable;
+    /* 足以存放一个 T 的暂存区，其中的对象逐字节搬走后不再析构 */
+    typedef typename std::aligned_storage<sizeof (T), alignof(T)>::type raw_storage;
     iterator start;             /* 目前使用空间的头 */
     iterator finish;            /* 目前使用空间的尾 */
     iterator end_of_storage;    /* 目前可用空间的尾 */
 
     void fill_initialize(size_type n, const T& value)
     {
-        start = allocate_and_fill(n, value);
+        const size_type cap = padded_size(n);
+        start = data_allocator::allocate(this->allocator(), cap);
+        mystl::uninitialized_fill_n(start, n, value);      /* mystl_uninitialized.hpp */
         finish = start + n;
-        end_of_storage = finish;
+        end_of_storage = start + cap;
+    }
+
+    static constexpr size_type gcd(size_type a, size_type b) { return b == 0 ? a : gcd(b, a % b); }
+    /* 容量必须是 pad_step 的整数倍，capacity() * sizeof (T) 才是对齐量的整数倍:
+     * pad_step = lcm(sizeof (T), align) / sizeof (T) = align / gcd(sizeof (T), align) */
+    static constexpr size_type pad_step()
+        { return (size_type) __alloc_align<Alloc>::value / gcd(sizeof (T), __alloc_align<Alloc>::value); }
+
+    /* Alloc 保证对齐 (如 align_alloc<32>) 时，把容量补齐到对齐量的整数倍，
+     * 于是 [begin(), begin() + capacity()) 可以按整块 SIMD 宽度处理 */
+    static size_type padded_size(size_type n)
+    {
+        const size_type step = pad_step();
+        if (step <= 1)
+            return n;
+        return (n + step - 1) / step * step;
     }
 
     void deallocate()
     {
         if (start)
-            data_allocator::deallocate(start, end_of_storage - start);
+            data_allocator::deallocate(this->allocator(), start, end_of_storage - start);
+    }
+
+    /* 容纳另外 n 个元素所需扩充到的容量 */
+    size_type next_capacity(size_type n)
+    {
+        return padded_size(Growth::next_capacity(capacity(), size() + n, sizeof (T)));
+    }
+
+    /* 把容量改为 new_cap (>= size()) */
+    void reallocate_storage(size_type new_cap, __true_type)
+    {
+        const size_type old_size = size();
+        start = data_allocator::reallocate(this->allocator(), start, capacity(), new_cap);
+        finish = start + old_size;
+        end_of_storage = start + new_cap;
+    }
+    void reallocate_storage(size_type new_cap, __false_type)
+    {
+        iterator new_start = data_allocator::allocate(this->allocator(), new_cap);
+        iterator new_finish;
+        try {
+            new_finish = mystl::uninitialized_move_if_noexcept(start, finish, new_start);
+        } catch (...) {
+            data_allocator::deallocate(this->allocator(), new_start, new_cap);
+            throw;
+        }
+        mystl::destroy(start, finish);
+        deallocate();
+        start = new_start;
+        finish = new_finish;
+        end_of_storage = new_start + new_cap;
     }
 
 public:
@@ -62,27 +181,97 @@ public:
     size_type capacity() { return size_type(end_of_storage - begin()); }
     bool empty() { return begin() == end(); }
     reference operator[] (size_type n) { return *(begin() + n); }
+    const_reference operator[] (size_type n) const { return *(start + n); }
+
+    using alloc_base::get_allocator;
+
+    /* 容量至少为 n，之后 n 个元素以内的插入不会重新配置空间 */
+    void reserve(size_type n)
+    {
+        if (n > capacity())
+            reallocate_storage(padded_size(n), relocatable());
+    }
+    /* 把容量缩小到 size()，归还多余的空间 */
+    void shrink_to_fit()
+    {
+        const size_type n = padded_size(size());
+        if (n == capacity())
+            return;
+        if (n == 0) {
+            deallocate();
+            start = finish = end_of_storage = 0;
+        }
+        else
+            reallocate_storage(n, relocatable());
+    }
 
 public:
-    /* 这些构造函数目前并没有考虑用户自定义alloc的情况 */
+    /* a 为有状态的配置器 (如 arena_alloc) 时，容器通过它配置空间 */
     vector() : start(0), finish(0), end_of_storage(0) {}
-    vector(size_type n, const T& value) { fill_initialize(n, value); }
-    vector(int n, const T& value) { fill_initialize(n, value); }
-    vector(long n, const T& value) { fill_initialize(n, value); }
-    explicit vector(size_type n) { fill_initialize(n, T()); }
+    explicit vector(const Alloc& a)
+        : alloc_base(a), start(0), finish(0), end_of_storage(0) {}
+    vector(size_type n, const T& value, const Alloc& a = Alloc())
+        : alloc_base(a) { fill_initialize(n, value); }
+    vector(int n, const T& value, const Alloc& a = Alloc())
+        : alloc_base(a) { fill_initialize(n, value); }
+    vector(long n, const T& value, const Alloc& a = Alloc())
+        : alloc_base(a) { fill_initialize(n, value); }
+    explicit vector(size_type n, const Alloc& a = Alloc())
+        : alloc_base(a) { fill_initialize(n, T()); }
+    /* ForwardIterator 先求出元素个数，只配置一次空间；
+     * InputIterator 只能逐个 emplace_back() */
     template <typename InputIterator>
-        vector(InputIterator first, InputIterator last)
+        vector(InputIterator first, InputIterator last, const Alloc& a = Alloc())
+            : alloc_base(a), start(0), finish(0), end_of_storage(0)
         {
-            start = allocate_and_fill(1, T());
-            finish = start;
-            end_of_storage = finish+1;
-            for (; first != last; ++first) {
-                push_back(*first);
-            }
+            typedef typename __bool_type<std::is_integral<InputIterator>::value>::type integral;
+            initialize_dispatch(first, last, integral());
+        }
+    /* 复制构造: 只配置 x.size() 个元素的空间，
+     * POD 型别经 __copy_dispatch 以 memmove() 复制 */
+    vector(const vector& x)
+        : alloc_base(x.get_allocator()), start(0), finish(0), end_of_storage(0)
+    {
+        range_initialize(x.start, x.finish, random_access_iterator_tag());
+    }
+    /* 复制赋值: 容量足够时复制到原有空间，不重新配置；配置器不随之复制 */
+    vector& operator= (const vector& x)
+    {
+        if (this != &x)
+            range_assign(x.start, x.finish, random_access_iterator_tag());
+        return *this;
+    }
+    /* 移动构造: 接管 x 的空间，x 成为空 vector */
+    vector(vector&& x) noexcept
+        : alloc_base(std::move(x.allocator())),
+          start(x.start), finish(x.finish), end_of_storage(x.end_of_storage)
+    {
+        x.start = x.finish = x.end_of_storage = 0;
+    }
+    vector& operator= (vector&& x) noexcept
+    {
+        if (this != &x) {
+            mystl::destroy(start, finish);
+            deallocate();
+            this->allocator() = std::move(x.allocator());
+            start = x.start;
+            finish = x.finish;
+            end_of_storage = x.end_of_storage;
+            x.start = x.finish = x.end_of_storage = 0;
         }
+        return *this;
+    }
+    /* 交换两个 vector 的空间与配置器，不复制任何元素 */
+    void swap(vector& x) noexcept
+    {
+        std::swap(this->allocator(), x.allocator());
+        std::swap(start, x.start);
+        std::swap(finish, x.finish);
+        std::swap(end_of_storage, x.end_of_storage);
+    }
     ~vector() 
     {
-        destroy(start, finish);             /* mystl_construct.hpp */
+        mystl::destroy(start, finish);             /* mystl_construct.hpp */
         deallocate();                       /* member fun */
     }
 
@@ -92,34 +281,41 @@ public:
     void push_back(const T& x) 
     {
         if (finish != end_of_storage) {
-            construct(finish, x);           /* mystl_construct.hpp */
+            mystl::construct(finish, x);           /* mystl_construct.hpp */
             ++finish;
         }
         else
             insert(end(), x);           /* member fun */
     }
+    void push_back(T&& x) { emplace_back(std::move(x)); }
+    /* 以 args 为参数直接在尾端构造元素 */
+    template <typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        if (finish != end_of_storage) {
+            mystl::construct(finish, std::forward<Args>(args)...);
+            ++finish;
+        }
+        else
+            realloc_emplace(finish, next_capacity(1), std::forward<Args>(args)...);
+    }
     void pop_back() 
     {
         --finish;
-        destroy(finish);
+        mystl::destroy(finish);
     }
 
     iterator erase(iterator position)
     {
         if (position == end())
             return position;
-        if (position + 1 != end())
-            copy(position + 1, finish, position);   /* 后续元素向前移动1格 */
-        --finish;
-        destroy(finish);
-        return position;
+        return erase_aux(position, position + 1, relocatable());
     }
     iterator erase(iterator first, iterator last)
     {
-        iterator i = copy(last, finish, first);     /* mystl_algobase.hpp */
-        destroy(i, finish);                         /* mystl_construct.hpp */
-        finish = finish - (last -first);
-        return first;
+        if (first == last)      /* 否则每个元素都要移动赋值给自己 */
+            return first;
+        return erase_aux(first, last, relocatable());
     }
     void resize(size_type new_size, const T& x)
     {
@@ -132,106 +328,604 @@ public:
     {
         resize(new_size, T());
     }
+    /* 与 resize() 相同，但新元素以缺省构造函数构造 (trivial 时不初始化) */
+    void resize_default_init(size_type new_size)
+    {
+        if (new_size < size())
+            erase(begin() + new_size, end());
+        else
+            append_uninitialized(new_size - size());
+    }
+    /* 在尾端追加 n 个以缺省构造函数构造 (trivial 时不初始化) 的元素，
+     * 返回第一个新元素的位置，供调用者直接写入 */
+    iterator append_uninitialized(size_type n)
+    {
+        if (size_type(end_of_storage - finish) < n)
+            reallocate_storage(next_capacity(n), relocatable());
+        iterator result = finish;
+        finish = mystl::uninitialized_default_n(finish, n);
+        return result;
+    }
     void clear() { erase(begin(), end()); }
+
+    /* 以 n 个 x 或 [first, last) 取代原有的内容，容量足够时不重新配置空间 */
+    void assign(size_type n, const T& x) { fill_assign(n, x); }
+    template <typename InputIterator>
+    void assign(InputIterator first, InputIterator last)
+    {
+        typedef typename __bool_type<std::is_integral<InputIterator>::value>::type integral;
+        assign_dispatch(first, last, integral());
+    }
+
     void insert(iterator position, size_type n, const T& x);
-    void insert(iterator position, const T& x);
+    /* [first, last) 不可以是本 vector 中的元素 */
+    template <typename InputIterator>
+    void insert(iterator position, InputIterator first, InputIterator last)
+    {
+        typedef typename __bool_type<std::is_integral<InputIterator>::value>::type integral;
+        insert_dispatch(position, first, last, integral());
+    }
+    iterator insert(iterator position, const T& x) { return emplace(position, x); }
+    iterator insert(iterator position, T&& x) { return emplace(position, std::move(x)); }
+    template <typename... Args>
+    iterator emplace(iterator position, Args&&... args);
 
 protected:
+    /* 整数型别的 (first, last) 其实是 (n, x) */
+    template <typename Integer>
+    void initialize_dispatch(Integer n, Integer x, __true_type)
+        { fill_initialize(n, x); }
+    template <typename InputIterator>
+    void initialize_dispatch(InputIterator first, InputIterator last, __false_type)
+        { range_initialize(first, last, iterator_category(first)); }
+    template <typename InputIterator>
+    void range_initialize(InputIterator first, InputIterator last, input_iterator_tag);
+    template <typename ForwardIterator>
+    void range_initialize(ForwardIterator first, ForwardIterator last, forward_iterator_tag);
+
+    template <typename Integer>
+    void assign_dispatch(Integer n, Integer x, __true_type)
+        { fill_assign(n, x); }
+    template <typename InputIterator>
+    void assign_dispatch(InputIterator first, InputIterator last, __false_type)
+        { range_assign(first, last, iterator_category(first)); }
+    void fill_assign(size_type n, const T& x);
+    template <typename InputIterator>
+    void range_assign(InputIterator first, InputIterator last, input_iterator_tag);
+    template <typename ForwardIterator>
+    void range_assign(ForwardIterator first, ForwardIterator last, forward_iterator_tag);
+
+    template <typename Integer>
+    void insert_dispatch(iterator position, Integer n, Integer x, __true_type)
+        { insert(position, (size_type) n, (T) x); }
+    template <typename InputIterator>
+    void insert_dispatch(iterator position, InputIterator first, InputIterator last,
+            __false_type)
+        { range_insert(position, first, last, iterator_category(first)); }
+    template <typename InputIterator>
+    void range_insert(iterator position, InputIterator first, InputIterator last,
+            input_iterator_tag);
+    template <typename ForwardIterator>
+    void range_insert(iterator position, ForwardIterator first, ForwardIterator last,
+            forward_iterator_tag);
+    /* 备用空间足够时，在 position 处插入 [first, last) 的 n 个元素 */
+    template <typename ForwardIterator>
+    void range_insert_aux(iterator position, ForwardIterator first, ForwardIterator last,
+            size_type n, __true_type);
+    template <typename ForwardIterator>
+    void range_insert_aux(iterator position, ForwardIterator first, ForwardIterator last,
+            size_type n, __false_type);
+    /* 备用空间不足时，扩充到 new_size 并在 position 处插入 [first, last) 的 n 个元素 */
+    template <typename ForwardIterator>
+    void range_realloc_insert(iterator position, ForwardIterator first, ForwardIterator last,
+            size_type n, size_type new_size, __true_type);
+    template <typename ForwardIterator>
+    void range_realloc_insert(iterator position, ForwardIterator first, ForwardIterator last,
+            size_type n, size_type new_size, __false_type);
+
+    /* 可逐字节搬移的型别: 先析构被删除的元素，再以 memmove() 把后续元素前移 */
+    iterator erase_aux(iterator first, iterator last, __true_type)
+    {
+        mystl::destroy(first, last);
+        memmove((void*) first, (void*) last, sizeof (T) * (finish - last));
+        finish -= last - first;
+        return first;
+    }
+    iterator erase_aux(iterator first, iterator last, __false_type)
+    {
+        iterator i = mystl::move(last, finish, first);     /* mystl_algobase.hpp */
+        mystl::destroy(i, finish);                         /* mystl_construct.hpp */
+        finish = finish - (last -first);
+        return first;
+    }
+
+    /* 备用空间足够时，在 position (!= finish) 处以 args 构造一个元素 */
+    template <typename... Args>
+    void emplace_aux(iterator position, __true_type, Args&&... args)
+    {
+        raw_storage buf;                /* args 可能引用本 vector 中的元素 */
+        mystl::construct((T*) &buf, std::forward<Args>(args)...);
+        memmove((void*) (position + 1), (void*) position, sizeof (T) * (finish - position));
+        memcpy((void*) position, &buf, sizeof (T));
+        ++finish;
+    }
+    template <typename... Args>
+    void emplace_aux(iterator position, __false_type, Args&&... args)
+    {
+        T x_copy(std::forward<Args>(args)...);  /* args 可能引用本 vector 中的元素 */
+        /* 在备用空间的起始处构造一个元素，以 vector 最后一个元素为初值 */
+        mystl::construct(finish, std::move(*(finish-1)));
+        ++finish;
+        mystl::move_backward(position, finish-2, finish-1);    /* mystl_algobase.hpp */
+        *position = std::move(x_copy);
+    }
+
+    /* 备用空间足够时，在 position 处插入 n 个 x */
+    void fill_insert_aux(iterator position, size_type n, const T& x, __true_type);
+    void fill_insert_aux(iterator position, size_type n, const T& x, __false_type);
+
+    /* 备用空间不足时，扩充到 new_size 并在 position 处以 args 构造一个元素 */
+    template <typename... Args>
+    void realloc_emplace(iterator position, size_type new_size, Args&&... args)
+    {
+        realloc_emplace_aux(position, new_size, relocatable(), std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    void realloc_emplace_aux(iterator position, size_type new_size,
+            __true_type, Args&&... args);
+    template <typename... Args>
+    void realloc_emplace_aux(iterator position, size_type new_size,
+            __false_type, Args&&... args);
+
+    /* 备用空间不足时，扩充到 new_size 并在 position 处插入 n 个 x */
+    void realloc_insert(iterator position, size_type n, const T& x, size_type new_size)
+    {
+        realloc_insert_aux(position, n, x, new_size, relocatable());
+    }
+    void realloc_insert_aux(iterator position, size_type n, const T& x,
+            size_type new_size, __true_type);
+    void realloc_insert_aux(iterator position, size_type n, const T& x,
+            size_type new_size, __false_type);
+
     iterator allocate_and_fill(size_type n, const T& x)
     {
-        iterator result = data_allocator::allocate(n);
-        uninitialized_fill_n(result, n, x);         /* mystl_uninitialized.hpp */
+        iterator result = data_allocator::allocate(this->allocator(), n);
+        mystl::uninitialized_fill_n(result, n, x);         /* mystl_uninitialized.hpp */
+        return result;
+    }
+    /* 配置 n 个元素的空间，并复制 [first, last) 到其中 */
+    template <typename ForwardIterator>
+    iterator allocate_and_copy(size_type n, ForwardIterator first, ForwardIterator last)
+    {
+        iterator result = data_allocator::allocate(this->allocator(), n);
+        try {
+            mystl::uninitialized_copy(first, last, result);
+        } catch (...) {
+            data_allocator::deallocate(this->allocator(), result, n);
+            throw;
+        }
         return result;
     }
 
 };
 
-/* insert() */
-template <typename T, typename Alloc>
-void vector<T, Alloc>::insert(iterator position, const T& x)
+template <typename T, typename Alloc, typename Growth>
+inline void swap(vector<T, Alloc, Growth>& x, vector<T, Alloc, Growth>& y) noexcept
 {
-    if (finish != end_of_storage) {     /* 还有备用空间 */
-        /* 在备用空间的起始处构造一个元素，以 vector 最后一个元素为初值 */
-        construct(finish, *(finish-1));
+    x.swap(y);
+}
+
+/* emplace() */
+template <typename T, typename Alloc, typename Growth>
+template <typename... Args>
+typename vector<T, Alloc, Growth>::iterator
+vector<T, Alloc, Growth>::emplace(iterator position, Args&&... args)
+{
+    const size_type elems_before = position - start;
+    if (finish != end_of_storage && position == finish) {
+        mystl::construct(finish, std::forward<Args>(args)...);
         ++finish;
-        copy_backward(position, finish-2, finish-1);    /* mystl_algobase.hpp */
-        *position = x;
+    }
+    else if (finish != end_of_storage) {     /* 还有备用空间 */
+        emplace_aux(position, relocatable(), std::forward<Args>(args)...);
     }
     else {
-        const size_type old_size = size();
-        const size_type new_size = old_size != 0 ? 2 * old_size : 1;
-        /* 配置原则: 增大2倍 */
+        /* 配置原则: 由 Growth 决定，缺省增大2倍 */
+        realloc_emplace(position, next_capacity(1), std::forward<Args>(args)...);
+    }
+    return start + elems_before;
+}
 
-        iterator new_start = data_allocator::allocate(new_size);
-        iterator new_finish = new_start;
-        try {
-            /* 拷贝原 vector 内容到新的 vector 中 */
-            new_finish = uninitialized_copy(start, position, new_start);
-            construct(new_finish, x);
-            ++new_finish;
-            new_finish = uninitialized_copy(position, finish, new_finish);
-        } catch (...) {
-            /* commit or rollback */
-            destroy(new_start, new_finish);
-            data_allocator::deallocate(new_start, new_size);
-            throw;
-        }
-        /* 析构，释放 原vector */
-        destroy(begin(), end());            /* mystl_construct.hpp */
-        deallocate();                       /* member fun */
+/* 可逐字节搬移的型别: 先在暂存区构造新元素 (args 可能引用原空间的元素)，
+ * 再以配置器的 reallocate() 扩充空间，最后把新元素逐字节放入 */
+template <typename T, typename Alloc, typename Growth>
+template <typename... Args>
+void vector<T, Alloc, Growth>::realloc_emplace_aux(iterator position, size_type new_size,
+        __true_type, Args&&... args)
+{
+    raw_storage buf;
+    mystl::construct((T*) &buf, std::forward<Args>(args)...);
 
-        start = new_start;
-        finish = new_finish;
-        end_of_storage = new_start + new_size;
+    const size_type old_size = size();
+    const size_type elems_before = position - start;
+    try {
+        start = data_allocator::reallocate(this->allocator(), start, capacity(), new_size);
+    } catch (...) {
+        mystl::destroy((T*) &buf);
+        throw;
+    }
+    finish = start + old_size;
+    end_of_storage = start + new_size;
+
+    position = start + elems_before;
+    memmove((void*) (position + 1), (void*) position, sizeof (T) * (old_size - elems_before));
+    memcpy((void*) position, &buf, sizeof (T));
+    ++finish;
+}
+
+/* 其他型别: 先在新空间构造新元素 (args 可能引用原空间的元素)，
+ * 再把原有元素搬到新空间: 移动构造不抛出异常时移动，否则复制 */
+template <typename T, typename Alloc, typename Growth>
+template <typename... Args>
+void vector<T, Alloc, Growth>::realloc_emplace_aux(iterator position, size_type new_size,
+        __false_type, Args&&... args)
+{
+    iterator new_start = data_allocator::allocate(this->allocator(), new_size);
+    iterator new_pos = new_start + (position - start);
+    try {
+        mystl::construct(new_pos, std::forward<Args>(args)...);
+    } catch (...) {
+        data_allocator::deallocate(this->allocator(), new_start, new_size);
+        throw;
+    }
+
+    iterator new_finish = new_start;
+    try {
+        new_finish = mystl::uninitialized_move_if_noexcept(start, position, new_start);
+        ++new_finish;
+        new_finish = mystl::uninitialized_move_if_noexcept(position, finish, new_finish);
+    } catch (...) {
+        /* commit or rollback */
+        mystl::destroy(new_start, new_finish);
+        if (new_finish <= new_pos)
+            mystl::destroy(new_pos);
+        data_allocator::deallocate(this->allocator(), new_start, new_size);
+        throw;
     }
+    mystl::destroy(start, finish);
+    deallocate();       /* member fun */
+
+    start = new_start;
+    finish = new_finish;
+    end_of_storage = new_start + new_size;
 }
 
 /* insert() */
-template <typename T, typename Alloc>
-void vector<T, Alloc>::insert(iterator position, size_type n, const T& x)
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::insert(iterator position, size_type n, const T& x)
 {
     if (n == 0) return;
     if (size_type(end_of_storage - finish) >= n) {  /* 备用空间足够 */
-        const size_type elems_after = finish - position;
-        iterator old_finish = finish;
-        if (elems_after > n) {
-            uninitialized_copy(finish-n, finish, finish);   /* mystl_algobase.hpp */
-            finish += n;
-            copy_backward(position, old_finish-n, old_finish);
-            fill(position, position+n, x);          /* mystl_algobase.hpp */
-        }
-        else {
-            uninitialized_fill_n(finish, n-elems_after, x); /* mystl_algobase.hpp */
-            finish += n - elems_after;
-            uninitialized_copy(position, old_finish, finish);
-            finish += elems_after;
-            fill(position, old_finish, x);
-        }
+        fill_insert_aux(position, n, x, relocatable());
     }
     else {
-        const size_type old_size = size();
-        const size_type new_size = old_size + max(old_size, n); /* mystl_algobase.hpp */
-        iterator new_start = data_allocator::allocate(new_size);
-        iterator new_finish = new_start;
+        realloc_insert(position, n, x, next_capacity(n));
+    }
+}
+
+/* 可逐字节搬移的型别: 后续元素以 memmove() 后移 n 格，再在空出的位置填入 x。
+ * 填入时发生异常，把后续元素移回原处 */
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::fill_insert_aux(iterator position, size_type n,
+        const T& x, __true_type)
+{
+    const T x_copy = x;                 /* x 可能是本 vector 中的元素 */
+    const size_type elems_after = finish - position;
+    memmove((void*) (position + n), (void*) position, sizeof (T) * elems_after);
+    try {
+        mystl::uninitialized_fill_n(position, n, x_copy);
+    } catch (...) {
+        memmove((void*) position, (void*) (position + n), sizeof (T) * elems_after);
+        throw;
+    }
+    finish += n;
+}
+
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::fill_insert_aux(iterator position, size_type n,
+        const T& x, __false_type)
+{
+    T x_copy = x;                   /* x 可能是本 vector 中的元素 */
+    const size_type elems_after = finish - position;
+    iterator old_finish = finish;
+    if (elems_after > n) {
+        mystl::uninitialized_move(finish-n, finish, finish);   /* mystl_uninitialized.hpp */
+        finish += n;
+        mystl::move_backward(position, old_finish-n, old_finish);
+        mystl::fill(position, position+n, x_copy);     /* mystl_algobase.hpp */
+    }
+    else {
+        mystl::uninitialized_fill_n(finish, n-elems_after, x_copy); /* mystl_algobase.hpp */
+        finish += n - elems_after;
+        mystl::uninitialized_move(position, old_finish, finish);
+        finish += elems_after;
+        mystl::fill(position, old_finish, x_copy);
+    }
+}
+
+/* 可逐字节搬移的型别 (包括所有 POD 型别): 以配置器的 reallocate() 扩充空间，
+ * 能原地扩展时不需要搬移元素，大区块由 mremap 重新映射，也不会复制内容 */
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::realloc_insert_aux(iterator position, size_type n,
+        const T& x, size_type new_size, __true_type)
+{
+    const T x_copy = x;                 /* x 可能是本 vector 中的元素 */
+    const size_type old_size = size();
+    const size_type elems_before = position - start;
+
+    start = data_allocator::reallocate(this->allocator(), start, capacity(), new_size);
+    finish = start + old_size;
+    end_of_storage = start + new_size;
+
+    position = start + elems_before;
+    fill_insert_aux(position, n, x_copy, __true_type());
+}
+
+/* 其他型别: 配置新空间，先填入 n 个 x (x 可能引用原空间的元素)，
+ * 再把原有元素搬到新空间，最后释放原空间 */
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::realloc_insert_aux(iterator position, size_type n,
+        const T& x, size_type new_size, __false_type)
+{
+    iterator new_start = data_allocator::allocate(this->allocator(), new_size);
+    iterator new_pos = new_start + (position - start);
+    try {
+        mystl::uninitialized_fill_n(new_pos, n, x);
+    } catch (...) {
+        data_allocator::deallocate(this->allocator(), new_start, new_size);
+        throw;
+    }
+
+    iterator new_finish = new_start;
+    try {
+        new_finish = mystl::uninitialized_move_if_noexcept(start, position, new_start);
+        new_finish += n;
+        new_finish = mystl::uninitialized_move_if_noexcept(position, finish, new_finish);
+    } catch(...) {
+        /* commit or rollback */
+        mystl::destroy(new_start, new_finish);
+        if (new_finish <= new_pos)
+            mystl::destroy(new_pos, new_pos + n);
+        data_allocator::deallocate(this->allocator(), new_start, new_size);
+        throw;
+    }
+    mystl::destroy(start, finish);
+    deallocate();       /* member fun */
+
+    start = new_start;
+    finish = new_finish;
+    end_of_storage = new_start + new_size;
+}
+
+/* range_initialize() */
+template <typename T, typename Alloc, typename Growth>
+template <typename InputIterator>
+void vector<T, Alloc, Growth>::range_initialize(InputIterator first, InputIterator last,
+        input_iterator_tag)
+{
+    try {
+        for (; first != last; ++first)
+            emplace_back(*first);
+    } catch (...) {
+        /* 构造函数抛出异常时不会调用析构函数 */
+        mystl::destroy(start, finish);
+        deallocate();
+        throw;
+    }
+}
+
+/* 元素个数已知，只配置一次空间。
+ * [first, last) 为 POD 型别的原生指针时，uninitialized_copy() 以 memmove() 复制 */
+template <typename T, typename Alloc, typename Growth>
+template <typename ForwardIterator>
+void vector<T, Alloc, Growth>::range_initialize(ForwardIterator first, ForwardIterator last,
+        forward_iterator_tag)
+{
+    const size_type n = mystl::distance(first, last);
+    const size_type cap = padded_size(n);
+    start = allocate_and_copy(cap, first, last);
+    finish = start + n;
+    end_of_storage = start + cap;
+}
+
+/* fill_assign() */
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::fill_assign(size_type n, const T& x)
+{
+    if (n > capacity()) {
+        const size_type cap = padded_size(n);
+        iterator new_start = data_allocator::allocate(this->allocator(), cap);
         try {
-            new_finish = uninitialized_copy(start, position, new_start);
-            new_finish = uninitialized_fill_n(new_finish, n, x);
-            new_finish = uninitialized_copy(position, finish, new_finish);
-        } catch(...) {
-            /* commit or rollback */
-            destroy(new_start, new_finish);
-            data_allocator::deallocate(new_start, new_size);
+            mystl::uninitialized_fill_n(new_start, n, x);
+        } catch (...) {
+            data_allocator::deallocate(this->allocator(), new_start, cap);
             throw;
         }
-        destroy(start, finish);
-        deallocate();       /* member fun */
+        mystl::destroy(start, finish);
+        deallocate();
+        start = new_start;
+        finish = new_start + n;
+        end_of_storage = new_start + cap;
+    }
+    else if (n > size()) {
+        mystl::fill(begin(), end(), x);
+        finish = mystl::uninitialized_fill_n(finish, n - size(), x);
+    }
+    else {
+        erase(mystl::fill_n(begin(), n, x), end());
+    }
+}
+
+/* range_assign() */
+template <typename T, typename Alloc, typename Growth>
+template <typename InputIterator>
+void vector<T, Alloc, Growth>::range_assign(InputIterator first, InputIterator last,
+        input_iterator_tag)
+{
+    iterator cur = begin();
+    for (; first != last && cur != end(); ++first, ++cur)
+        *cur = *first;
+    if (first == last)
+        erase(cur, end());
+    else
+        range_insert(end(), first, last, input_iterator_tag());
+}
 
+/* 容量足够时复制到原有空间，不重新配置 */
+template <typename T, typename Alloc, typename Growth>
+template <typename ForwardIterator>
+void vector<T, Alloc, Growth>::range_assign(ForwardIterator first, ForwardIterator last,
+        forward_iterator_tag)
+{
+    const size_type n = mystl::distance(first, last);
+    if (n > capacity()) {
+        const size_type cap = padded_size(n);
+        iterator new_start = allocate_and_copy(cap, first, last);
+        mystl::destroy(start, finish);
+        deallocate();
         start = new_start;
-        finish = new_finish;
-        end_of_storage = new_start + new_size;
+        finish = new_start + n;
+        end_of_storage = new_start + cap;
+    }
+    else if (n > size()) {
+        ForwardIterator mid = first;
+        mystl::advance(mid, size());
+        mystl::copy(first, mid, start);
+        finish = mystl::uninitialized_copy(mid, last, finish);
+    }
+    else {
+        erase(mystl::copy(first, last, start), end());
     }
 }
 
+/* range_insert()
+ * InputIterator 只能逐个插入 */
+template <typename T, typename Alloc, typename Growth>
+template <typename InputIterator>
+void vector<T, Alloc, Growth>::range_insert(iterator position,
+        InputIterator first, InputIterator last, input_iterator_tag)
+{
+    for (; first != last; ++first) {
+        position = emplace(position, *first);
+        ++position;
+    }
+}
+
+/* ForwardIterator 先求出元素个数，最多重新配置一次空间 */
+template <typename T, typename Alloc, typename Growth>
+template <typename ForwardIterator>
+void vector<T, Alloc, Growth>::range_insert(iterator position,
+        ForwardIterator first, ForwardIterator last, forward_iterator_tag)
+{
+    const size_type n = mystl::distance(first, last);
+    if (n == 0)
+        return;
+    if (size_type(end_of_storage - finish) >= n)    /* 备用空间足够 */
+        range_insert_aux(position, first, last, n, relocatable());
+    else
+        range_realloc_insert(position, first, last, n, next_capacity(n), relocatable());
+}
+
+/* 可逐字节搬移的型别: 后续元素以 memmove() 后移 n 格，再在空出的位置复制 [first, last)。
+ * 复制时发生异常，把后续元素移回原处 */
+template <typename T, typename Alloc, typename Growth>
+template <typename ForwardIterator>
+void vector<T, Alloc, Growth>::range_insert_aux(iterator position,
+        ForwardIterator first, ForwardIterator last, size_type n, __true_type)
+{
+    const size_type elems_after = finish - position;
+    memmove((void*) (position + n), (void*) position, sizeof (T) * elems_after);
+    try {
+        mystl::uninitialized_copy(first, last, position);
+    } catch (...) {
+        memmove((void*) position, (void*) (position + n), sizeof (T) * elems_after);
+        throw;
+    }
+    finish += n;
+}
+
+template <typename T, typename Alloc, typename Growth>
+template <typename ForwardIterator>
+void vector<T, Alloc, Growth>::range_insert_aux(iterator position,
+        ForwardIterator first, ForwardIterator last, size_type n, __false_type)
+{
+    const size_type elems_after = finish - position;
+    iterator old_finish = finish;
+    if (elems_after > n) {
+        mystl::uninitialized_move(finish-n, finish, finish);
+        finish += n;
+        mystl::move_backward(position, old_finish-n, old_finish);
+        mystl::copy(first, last, position);
+    }
+    else {
+        ForwardIterator mid = first;
+        mystl::advance(mid, elems_after);
+        mystl::uninitialized_copy(mid, last, finish);
+        finish += n - elems_after;
+        mystl::uninitialized_move(position, old_finish, finish);
+        finish += elems_after;
+        mystl::copy(first, mid, position);
+    }
+}
+
+template <typename T, typename Alloc, typename Growth>
+template <typename ForwardIterator>
+void vector<T, Alloc, Growth>::range_realloc_insert(iterator position,
+        ForwardIterator first, ForwardIterator last, size_type n, size_type new_size,
+        __true_type)
+{
+    const size_type elems_before = position - start;
+    reallocate_storage(new_size, __true_type());
+    range_insert_aux(start + elems_before, first, last, n, __true_type());
+}
+
+/* 与 realloc_insert_aux() 相同: 先在新空间复制 [first, last)，再把原有元素搬过去 */
+template <typename T, typename Alloc, typename Growth>
+template <typename ForwardIterator>
+void vector<T, Alloc, Growth>::range_realloc_insert(iterator position,
+        ForwardIterator first, ForwardIterator last, size_type n, size_type new_size,
+        __false_type)
+{
+    iterator new_start = data_allocator::allocate(this->allocator(), new_size);
+    iterator new_pos = new_start + (position - start);
+    try {
+        mystl::uninitialized_copy(first, last, new_pos);
+    } catch (...) {
+        data_allocator::deallocate(this->allocator(), new_start, new_size);
+        throw;
+    }
+
+    iterator new_finish = new_start;
+    try {
+        new_finish = mystl::uninitialized_move_if_noexcept(start, position, new_start);
+        new_finish += n;
+        new_finish = mystl::uninitialized_move_if_noexcept(position, finish, new_finish);
+    } catch(...) {
+        /* commit or rollback */
+        mystl::destroy(new_start, new_finish);
+        if (new_finish <= new_pos)
+            mystl::destroy(new_pos, new_pos + n);
+        data_allocator::deallocate(this->allocator(), new_start, new_size);
+        throw;
+    }
+    mystl::destroy(start, finish);
+    deallocate();       /* member fun */
+
+    start = new_start;
+    finish = new_finish;
+    end_of_storage = new_start + new_size;
+}
+
 }
 
 #endif
@@ -0,0 +1,146 @@
+/* file		: tests/slab_alloc_move_test.cpp
+ * by		: waterlemon	429426523@qq.com
+ * date		: Sun 18 Oct 2026 09:02:47 PM CST
+ * last update	:
+ *
+ * description	: 有状态配置器随容器移动的回归测试
+ * slab_alloc 的区块属于配置器对象本身。vector 与 small_vector 的移动构造/移动赋值
+ * 如果复制配置器，得到的是一个空的 slab_alloc，x 析构时 slab 被归还，
+ * 移动得到的容器仍然指向那些区块 (use-after-free)。
+ * list 的 splice() 与 merge() 同理: 两个 slab_alloc 不相等，结点不能直接接过去，
+ * 否则 x 析构后本 list 的结点已被归还。
+ *
+ * 编译: g++ -std=c++11 -g -fsanitize=address -I.. slab_alloc_move_test.cpp -o slab_alloc_move_test
+ * 执行: ./slab_alloc_move_test，成功时输出 ok；不带 -fsanitize=address 时靠覆写检查发现错误
+ */
+
+#include "mystl_slab_alloc.hpp"
+#include "mystl_vector.hpp"
+#include "mystl_small_vector.hpp"
+#include "mystl_list.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <utility>
+
+enum { __TEST_N = 100 };
+
+/* 释放的 slab 被重新配置并覆写之后，v 的内容仍然要正确 */
+template <typename V>
+void check(V& v)
+{
+    V other;
+    other.reserve(__TEST_N);
+    for (int i = 0; i < __TEST_N; i++)
+        other.push_back(-1);
+    assert(v.size() == (size_t) __TEST_N);
+    for (int i = 0; i < __TEST_N; i++)
+        assert(v[i] == i);
+    v.push_back(__TEST_N);
+    assert(v[__TEST_N] == __TEST_N);
+}
+
+/* 先 reserve()，使元素所在的空间是 slab_alloc 的第一个配置大小，从 slab 中切出 */
+template <typename V>
+void fill(V& v)
+{
+    v.reserve(__TEST_N);
+    for (int i = 0; i < __TEST_N; i++)
+        v.push_back(i);
+}
+
+template <typename V>
+void test_move_construct()
+{
+    V* x = new V;
+    fill(*x);
+    V v(std::move(*x));
+    delete x;
+    check(v);
+}
+
+template <typename V>
+void test_move_assign()
+{
+    V v;
+    v.push_back(0);     /* v 原有的区块要在赋值时归还给 v 自己的配置器 */
+    {
+        V x;
+        fill(x);
+        v = std::move(x);
+    }
+    check(v);
+}
+
+typedef mystl::list<int, mystl::slab_alloc<mystl::malloc_alloc> > slab_list;
+
+/* l 应为 0, 1, ..., n - 1 */
+void check_list(slab_list& l, int n)
+{
+    slab_list other;
+    for (int i = 0; i < n; i++)
+        other.push_back(-1);
+    assert(l.size() == (size_t) n);
+    int i = 0;
+    for (slab_list::iterator it = l.begin(); it != l.end(); ++it)
+        assert(*it == i++);
+    assert(i == n);
+}
+
+void test_list_splice()
+{
+    slab_list l;
+    {
+        slab_list x;
+        for (int i = 0; i < __TEST_N; i++)
+            x.push_back(i);
+        l.splice(l.end(), x);
+        assert(x.empty());
+    }
+    check_list(l, __TEST_N);
+
+    slab_list m;
+    {
+        slab_list x;
+        for (int i = 0; i < __TEST_N; i++)
+            x.push_back(i);
+        m.splice(m.end(), x, x.begin());                /* 0 */
+        slab_list::iterator last = x.end();
+        --last;
+        m.splice(m.end(), x, x.begin(), last);          /* 1 ... n - 2 */
+        m.splice(m.end(), x, x.begin());                /* n - 1 */
+        assert(x.empty());
+    }
+    check_list(m, __TEST_N);
+}
+
+void test_list_merge()
+{
+    slab_list l;
+    for (int i = 0; i < __TEST_N; i += 2)
+        l.push_back(i);
+    {
+        slab_list x;
+        for (int i = 1; i < __TEST_N; i += 2)
+            x.push_back(i);
+        l.merge(x);
+        assert(x.empty());
+    }
+    check_list(l, __TEST_N);
+}
+
+int main()
+{
+    typedef mystl::vector<int, mystl::slab_alloc<> >          vec;
+    typedef mystl::small_vector<int, 4, mystl::slab_alloc<> > small_vec;
+
+    test_move_construct<vec>();
+    test_move_assign<vec>();
+    test_move_construct<small_vec>();
+    test_move_assign<small_vec>();
+    test_list_splice();
+    test_list_merge();
+
+    printf("ok\n");
+    return 0;
+}